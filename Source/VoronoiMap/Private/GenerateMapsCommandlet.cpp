@@ -0,0 +1,281 @@
+/**
+ * @author Devin DeMatto
+ * @file GenerateMapsCommandlet.cpp
+ */
+
+#include "GenerateMapsCommandlet.h"
+#include "MapGeneration.h"
+#include "MapGraph.h"
+#include "MapNode.h"
+#include "NodeEdge.h"
+#include "TerrainGenerator.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/StrongObjectPtr.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogGenerateMaps, Log, All);
+
+UGenerateMapsCommandlet::UGenerateMapsCommandlet(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+/**
+ * Builds Graphs for a Batch of Seeds Across Worker Threads, Then Meshes, Terrain & Writes Each Map in Turn
+ * Terrain stays on one thread, the noise library keeps its seed in global state
+ * @param Params Command Line
+ * @return 0 on Success
+ */
+int32 UGenerateMapsCommandlet::Main(const FString& Params)
+{
+	const TArray<int32> Seeds = ParseSeeds(Params);
+	if (Seeds.IsEmpty())
+	{
+		UE_LOG(LogGenerateMaps, Error, TEXT("No seeds given, use -Seeds=1,2,3, -SeedFile=Path or -Count=N"));
+		return 1;
+	}
+
+	FString OutputDir = FPaths::ProjectSavedDir() / TEXT("GeneratedMaps");
+	FParse::Value(*Params, TEXT("Output="), OutputDir, false);
+	IFileManager::Get().MakeDirectory(*OutputDir, true);
+
+	int32 Workers = FMath::Max(FTaskGraphInterface::Get().GetNumWorkerThreads(), 1);
+	FParse::Value(*Params, TEXT("Workers="), Workers);
+	Workers = FMath::Max(Workers, 1);
+
+	// One Generator is Reused for Every Map, its Nodes & Edges are Recycled Between Them
+	// Held Strongly so Garbage Collection Between Maps Can't Take it
+	const TStrongObjectPtr<UMapGeneration> MapGen(NewObject<UMapGeneration>(GetTransientPackage()));
+	MapGen->InitializeModules();
+	MapGen->bUseLODPyramid = false;
+	ApplyOverrides(MapGen.Get(), Params);
+	ApplyOverrides(MapGen->TerrainGen, Params);
+
+	// Terrain Seeds Follow the Map Seed Unless Fixed on the Command Line
+	int32 FixedSeed = 0;
+	const bool bFixedTerrainSeed = FParse::Value(*Params, TEXT("TerrainSeed="), FixedSeed);
+	const bool bFixedBiomeSeed = FParse::Value(*Params, TEXT("BiomeSeed="), FixedSeed);
+
+	const FMapGraphSettings BaseSettings = MapGen->MakeGraphSettings();
+
+	int32 NumFailed = 0;
+	for (int32 BatchStart = 0; BatchStart < Seeds.Num(); BatchStart += Workers)
+	{
+		const int32 BatchSize = FMath::Min(Workers, Seeds.Num() - BatchStart);
+
+		// Graph Stages Touch no UObjects, One Map Per Worker
+		TArray<FMapGraphSettings> BatchSettings;
+		TArray<FMapGraphData> BatchGraphs;
+		BatchSettings.Init(BaseSettings, BatchSize);
+		BatchGraphs.SetNum(BatchSize);
+
+		ParallelFor(BatchSize, [&](const int32 Index)
+		{
+			BatchSettings[Index].Seed = Seeds[BatchStart + Index];
+			BatchSettings[Index].bParallel = false;
+			FMapGraphBuilder::Build(BatchSettings[Index], BatchGraphs[Index]);
+		});
+
+		for (int32 Index = 0; Index < BatchSize; ++Index)
+		{
+			const int32 Seed = Seeds[BatchStart + Index];
+
+			FRandomStream TerrainStream(Seed);
+			const int32 TerrainSeed = TerrainStream.RandRange(0, 1000);
+			const int32 BiomeSeed = TerrainStream.RandRange(0, 1000);
+			if (!bFixedTerrainSeed) MapGen->TerrainGen->TerrainSeed = TerrainSeed;
+			if (!bFixedBiomeSeed) MapGen->TerrainGen->BiomeSeed = BiomeSeed;
+
+			MapGen->ApplyGraph(BatchSettings[Index], BatchGraphs[Index]);
+
+			const FString FilePath = OutputDir / FString::Printf(TEXT("Map_%d.json"), Seed);
+			if (!SaveMap(MapGen.Get(), Seed, FilePath))
+			{
+				UE_LOG(LogGenerateMaps, Error, TEXT("Failed to write %s"), *FilePath);
+				++NumFailed;
+			}
+		}
+
+		UE_LOG(LogGenerateMaps, Display, TEXT("Generated %d / %d maps"), BatchStart + BatchSize, Seeds.Num());
+	}
+
+	return NumFailed > 0 ? 1 : 0;
+}
+
+////////////////////////
+// Commandlet Helpers //
+////////////////////////
+
+// Seeds From -Seeds, -SeedFile or -Count & -FirstSeed, in That Order of Preference
+TArray<int32> UGenerateMapsCommandlet::ParseSeeds(const FString& Params)
+{
+	TArray<int32> Seeds;
+	TArray<FString> SeedStrings;
+
+	FString SeedList;
+	FString SeedFile;
+	int32 Count = 0;
+
+	if (FParse::Value(*Params, TEXT("Seeds="), SeedList, false))
+	{
+		SeedList.ParseIntoArray(SeedStrings, TEXT(","));
+	}
+	else if (FParse::Value(*Params, TEXT("SeedFile="), SeedFile, false))
+	{
+		FFileHelper::LoadFileToStringArray(SeedStrings, *SeedFile);
+	}
+	else if (FParse::Value(*Params, TEXT("Count="), Count))
+	{
+		int32 FirstSeed = 0;
+		FParse::Value(*Params, TEXT("FirstSeed="), FirstSeed);
+
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			Seeds.Add(FirstSeed + Index);
+		}
+	}
+
+	for (const FString& SeedString : SeedStrings)
+	{
+		const FString Trimmed = SeedString.TrimStartAndEnd();
+		if (Trimmed.IsNumeric())
+		{
+			Seeds.Add(FCString::Atoi(*Trimmed));
+		}
+	}
+
+	return Seeds;
+}
+
+/**
+ * Sets Editable Properties Named on the Command Line, e.g. -Spacing=20 or -MapSize=(X=1000,Y=1000)
+ * @param Object Object to Configure
+ * @param Params Command Line
+ */
+void UGenerateMapsCommandlet::ApplyOverrides(UObject* Object, const FString& Params)
+{
+	for (TFieldIterator<FProperty> It(Object->GetClass()); It; ++It)
+	{
+		FProperty* Property = *It;
+		if (!Property->HasAnyPropertyFlags(CPF_Edit))
+		{
+			continue;
+		}
+
+		FString Value;
+		if (FParse::Value(*Params, *(Property->GetName() + TEXT("=")), Value, false))
+		{
+			Property->ImportText_InContainer(*Value, Object, Object, PPF_None);
+			UE_LOG(LogGenerateMaps, Display, TEXT("%s = %s"), *Property->GetName(), *Value);
+		}
+	}
+}
+
+/**
+ * Writes Vertices, Nodes & Edges of the Current Map, Which Reference Each Other by Index
+ * @param MapGen Generated Map
+ * @param Seed Seed the Map Was Generated From
+ * @param FilePath Destination File
+ * @return False if the File Couldn't be Written
+ */
+bool UGenerateMapsCommandlet::SaveMap(UMapGeneration* MapGen, const int32 Seed, const FString& FilePath)
+{
+	const TArray<UMapNode*>& Nodes = MapGen->GetNodes();
+	const TArray<UNodeEdge*>& Edges = MapGen->GetEdges();
+
+	TMap<const UMapNode*, int32> NodeIndices;
+	NodeIndices.Reserve(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		NodeIndices.Add(Nodes[Index], Index);
+	}
+
+	const auto WritePoint = [](const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>>& Writer, const FVector2D& Point)
+	{
+		Writer->WriteArrayStart();
+		Writer->WriteValue(Point.X);
+		Writer->WriteValue(Point.Y);
+		Writer->WriteArrayEnd();
+	};
+
+	FString Json;
+	const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Json);
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("Seed"), Seed);
+	Writer->WriteIdentifierPrefix(TEXT("MapSize"));
+	WritePoint(Writer, MapGen->GetMapSize());
+
+	// Shared Voronoi Vertices
+	Writer->WriteArrayStart(TEXT("Vertices"));
+	for (const FVector2D& Vertex : MapGen->GetVertices())
+	{
+		WritePoint(Writer, Vertex);
+	}
+	Writer->WriteArrayEnd();
+
+	// Nodes
+	Writer->WriteArrayStart(TEXT("Nodes"));
+	for (const UMapNode* Node : Nodes)
+	{
+		Writer->WriteObjectStart();
+		Writer->WriteIdentifierPrefix(TEXT("Centroid"));
+		WritePoint(Writer, Node->GetCentroid());
+		Writer->WriteValue(TEXT("Height"), Node->GetHeight());
+		Writer->WriteValue(TEXT("Biome"), StaticEnum<EBiomeType>()->GetNameStringByValue(static_cast<int64>(Node->GetBiome())));
+
+		Writer->WriteArrayStart(TEXT("Vertices"));
+		for (const FVector2D& Vertex : Node->GetOutline())
+		{
+			WritePoint(Writer, Vertex);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteArrayStart(TEXT("Neighbors"));
+		for (const UMapNode* Neighbor : Node->Neighbors)
+		{
+			Writer->WriteValue(NodeIndices.FindChecked(Neighbor));
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	// Edges
+	Writer->WriteArrayStart(TEXT("Edges"));
+	for (int32 EdgeIndex = 0; EdgeIndex < Edges.Num(); ++EdgeIndex)
+	{
+		const UNodeEdge* Edge = Edges[EdgeIndex];
+		const FMapEdgeNodes& Pair = MapGen->GetEdgeNodes()[EdgeIndex];
+
+		Writer->WriteObjectStart();
+		Writer->WriteValue(TEXT("VertexA"), Edge->VertexA);
+		Writer->WriteValue(TEXT("VertexB"), Edge->VertexB);
+		Writer->WriteValue(TEXT("Type"), StaticEnum<EEdgeType>()->GetNameStringByValue(static_cast<int64>(Edge->EdgeType)));
+
+		Writer->WriteArrayStart(TEXT("Nodes"));
+		for (const int32 NodeIndex : Pair.Nodes)
+		{
+			if (NodeIndex != INDEX_NONE)
+			{
+				Writer->WriteValue(NodeIndex);
+			}
+		}
+		Writer->WriteArrayEnd();
+		Writer->WriteObjectEnd();
+	}
+	Writer->WriteArrayEnd();
+
+	Writer->WriteObjectEnd();
+	Writer->Close();
+
+	return FFileHelper::SaveStringToFile(Json, *FilePath);
+}
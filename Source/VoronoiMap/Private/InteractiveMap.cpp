@@ -25,6 +25,9 @@ void UInteractiveMap::NativeConstruct()
 	SetIsFocusable(true);
 
 	SetClipping(EWidgetClipping::ClipToBoundsWithoutIntersecting);
+
+	// Only Repaint When Pan, Zoom, Selection or Map Data Change
+	ForceVolatile(false);
 }
 
 void UInteractiveMap::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
@@ -43,6 +46,7 @@ void UInteractiveMap::NativeTick(const FGeometry& MyGeometry, const float InDelt
 
 		// Calculate ViewportSize on Startup
 		UpdateViewportSize();
+		InvalidateMap();
 	}
 }
 
@@ -69,6 +73,7 @@ FReply UInteractiveMap::NativeOnMouseWheel(const FGeometry& InGeometry, const FP
 
 	// Reposition the viewport if needed
 	RepositionViewportIfNeeded();
+	InvalidateMap();
 
 	return FReply::Handled();
 }
@@ -130,6 +135,8 @@ FReply UInteractiveMap::NativeOnMouseMove(const FGeometry& InGeometry, const FPo
 			ViewportPosition.X = FMath::Clamp(ViewportPosition.X, ViewportSize.X / 2, MapSize.X - ViewportSize.X / 2);
 			ViewportPosition.Y = FMath::Clamp(ViewportPosition.Y, ViewportSize.Y / 2, MapSize.Y - ViewportSize.Y / 2);
 		}
+
+		InvalidateMap();
 	}
 	else
 	{
@@ -186,6 +193,32 @@ void UInteractiveMap::RepositionViewportIfNeeded()
 	ViewportPosition = ViewportTopLeft + (ViewportSize / 2);
 }
 
+/**
+ * Queues a Repaint of the Map Widget's Own Drawing, Borders & Center
+ */
+void UInteractiveMap::InvalidateMap()
+{
+	Invalidate(EInvalidateWidgetReason::Paint);
+}
+
+void UInteractiveMap::SetShowWidgetBorder(const bool bInShowWidgetBorder)
+{
+	if (ShowWidgetBorder != bInShowWidgetBorder)
+	{
+		ShowWidgetBorder = bInShowWidgetBorder;
+		InvalidateMap();
+	}
+}
+
+void UInteractiveMap::SetShowMapCenter(const bool bInShowMapCenter)
+{
+	if (ShowMapCenter != bInShowMapCenter)
+	{
+		ShowMapCenter = bInShowMapCenter;
+		InvalidateMap();
+	}
+}
+
 /**
  * Converts Virtual Points to Widget Space
  * @param VirtualPoint The Point being Translated
@@ -206,6 +239,28 @@ FVector2D UInteractiveMap::TranslateToWidgetSpace(const FVector2D& VirtualPoint)
 	return RelativePosition * ScaleFactor;
 }
 
+/**
+ * Scale & Offset Applied by TranslateToWidgetSpace, so Batched Geometry Can be Transformed in One Step
+ * @return Transform From Map Space to Widget Space
+ */
+FSlateRenderTransform UInteractiveMap::GetMapToWidgetTransform() const
+{
+	const FVector2D ViewportTopLeft = ViewportPosition - (ViewportSize / 2);
+	const FVector2D ScaleFactor = WidgetSize / ViewportSize;
+
+	return FSlateRenderTransform(FScale2f(FVector2f(ScaleFactor)), FVector2f(-ViewportTopLeft * ScaleFactor));
+}
+
+/**
+ * Map Space Straight to Render Space, Retained Geometry is Transformed by This Alone
+ * @param AllottedGeometry Geometry the Map is Painted in
+ * @return Transform From Map Space to Render Space
+ */
+FSlateRenderTransform UInteractiveMap::GetMapToRenderTransform(const FGeometry& AllottedGeometry) const
+{
+	return Concatenate(GetMapToWidgetTransform(), AllottedGeometry.GetAccumulatedRenderTransform());
+}
+
 /**
  * Converts Cursor Position to Position on Map
  * @param ScreenPoint Point on Screen
@@ -223,7 +278,9 @@ FVector2D UInteractiveMap::TranslateToVirtualSpace(const FVector2D& ScreenPoint)
 
 int32 UInteractiveMap::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
 {
-	const auto InContext = FPaintContext(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
+	// Borders & Center Sit Above Everything the Map Draws
+	const int32 OverlayLayerId = GetMapLayer(LayerId, EMapLayer::Overlay);
+	const auto InContext = FPaintContext(AllottedGeometry, MyCullingRect, OutDrawElements, OverlayLayerId, InWidgetStyle, bParentEnabled);
 
 	// Draw the Widget Drawing Space
 	DrawWidgetBorder(InContext, AllottedGeometry);
@@ -234,10 +291,25 @@ int32 UInteractiveMap::NativePaint(const FPaintArgs& Args, const FGeometry& Allo
 	// Center of Map
 	if (ShowMapCenter)
 	{
-		DrawPoint(InContext, AllottedGeometry, MapSize / 2, FLinearColor::Red, FVector2D(5.0f, 5.0f));
+		DrawPoint(MapSize / 2, FLinearColor::Red, FVector2D(5.0f, 5.0f));
 	}
 
-	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId + 1, InWidgetStyle, bParentEnabled);
+	PaintOverlayPoints(OutDrawElements, OverlayLayerId, AllottedGeometry);
+
+	const int32 MaxLayerId = Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, GetMapLayer(LayerId, EMapLayer::Num), InWidgetStyle, bParentEnabled);
+	return FMath::Max(MaxLayerId, OverlayLayerId);
+}
+
+/**
+ * Draws Every Marker Queued Since the Last Call as One Element
+ * @param OutDrawElements Element List Being Painted
+ * @param LayerId Layer the Markers Go on
+ * @param AllottedGeometry Geometry the Map is Painted in
+ */
+void UInteractiveMap::PaintOverlayPoints(FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FGeometry& AllottedGeometry) const
+{
+	OverlayPoints.Paint(OutDrawElements, LayerId, GetMapToRenderTransform(AllottedGeometry), AllottedGeometry.Scale);
+	OverlayPoints.Reset();
 }
 
 void UInteractiveMap::DrawWidgetBorder(const FPaintContext& InContext, const FGeometry& AllottedGeometry) const
@@ -290,24 +362,10 @@ void UInteractiveMap::DrawMapBorder(const FPaintContext& InContext, const FGeome
 // Public Drawing Methods //
 ////////////////////////////
 
-void UInteractiveMap::DrawPoint(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const FVector2D& VirtualPoint, const FLinearColor& Color, const FVector2D Size) const
+// Queues a Marker, Queued Markers are Drawn as One Batch on the Overlay Layer Once the Map Finishes Painting
+void UInteractiveMap::DrawPoint(const FVector2D& VirtualPoint, const FLinearColor& Color, const FVector2D Size) const
 {
-	// Translate the virtual point to widget space
-	FVector2D WidgetSpacePoint = TranslateToWidgetSpace(VirtualPoint);
-
-	//// Adjust WidgetSpacePoint to center the box on the point
-	WidgetSpacePoint -= Size * 0.5f;
-
-	//// Create a paint geometry for the box at the widget space position
-	//// Updated to use the newer API as suggested by the warning
-	const FPaintGeometry PaintGeometry = AllottedGeometry.ToPaintGeometry(Size, FSlateLayoutTransform(WidgetSpacePoint));
-
-	//// Create a brush for the box
-	FSlateBrush BoxBrush;
-	BoxBrush.TintColor = FSlateColor(Color);
-
-	// Draw the box
-	FSlateDrawElement::MakeBox(InContext.OutDrawElements, InContext.LayerId, PaintGeometry, &BoxBrush, ESlateDrawEffect::None, Color);
+	OverlayPoints.AddPoint(VirtualPoint, Color.ToFColor(true), Size);
 }
 
 void UInteractiveMap::DrawLine(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const FVector2D& VirtualStartPoint, const FVector2D& VirtualEndPoint, const FLinearColor& Color, const double Thickness) const
@@ -334,14 +392,15 @@ void UInteractiveMap::DrawLine(const FPaintContext& InContext, const FGeometry&
 	);
 }
 
-void UInteractiveMap::DrawLines(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const TArray<FVector2D>& Points, const FLinearColor& Color, const double Thickness) const
+void UInteractiveMap::DrawLines(const FPaintContext& InContext, const FGeometry& AllottedGeometry, TArrayView<const FVector2D> Points, const FLinearColor& Color, const double Thickness) const
 {
-	// Create an array of points in widget space
+	// Create an array of points in widget space, one affine for every point
+	const FSlateRenderTransform MapToWidget = GetMapToWidgetTransform();
 	TArray<FVector2D> WidgetSpacePoints;
+	WidgetSpacePoints.Reserve(Points.Num());
 	for (const FVector2D& Point : Points)
 	{
-		FVector2D WidgetSpacePoint = TranslateToWidgetSpace(Point);
-		WidgetSpacePoints.Add(WidgetSpacePoint);
+		WidgetSpacePoints.Add(FVector2D(MapToWidget.TransformPoint(FVector2f(Point))));
 	}
 
 	// Draw the lines using Slate's drawing system
@@ -357,22 +416,22 @@ void UInteractiveMap::DrawLines(const FPaintContext& InContext, const FGeometry&
 	);
 }
 
-void UInteractiveMap::DrawPolygon(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const TArray<FVector2D>& Vertices, const TArray<SlateIndex>& Indices, const FColor& Color) const
+void UInteractiveMap::DrawPolygon(const FPaintContext& InContext, const FGeometry& AllottedGeometry, TArrayView<const FVector2D> Vertices, const TArray<SlateIndex>& Indices, const FColor& Color) const
 {
 	// Array for FSlateVertex
 	TArray<FSlateVertex> SlateVertices;
+	SlateVertices.Reserve(Vertices.Num());
 
 	// Default texture coordinates
 	FVector2f DefaultTexCoord(0.0f, 0.0f);
 
+	// Map space goes straight to render space, pan & zoom are part of the transform
+	const FSlateRenderTransform MapToRender = GetMapToRenderTransform(AllottedGeometry);
+
 	// Convert each vertex to FSlateVertex
 	for (const FVector2D& Vertex : Vertices)
 	{
-		// Convert to widget space using TranslateToWidgetSpace
-		const FVector2f WidgetSpaceVertex = FVector2f(TranslateToWidgetSpace(Vertex));
-
-		// Make FSlateVertex and add to the array
-		SlateVertices.Add(FSlateVertex::Make(AllottedGeometry.GetAccumulatedRenderTransform(), WidgetSpaceVertex, DefaultTexCoord, Color));
+		SlateVertices.Add(FSlateVertex::Make(MapToRender, FVector2f(Vertex), DefaultTexCoord, Color));
 	}
 
 	// Draw the polygon using the vertices and indices
@@ -401,6 +460,7 @@ void UInteractiveMap::SetMapSize(const FVector2D Size)
 {
 	MapSize = Size;
 	UpdateViewportSize();
+	InvalidateMap();
 }
 
 //////////////////////////////////////
@@ -5,63 +5,132 @@
 
 #include "MapGeneration.h"
 #include "TerrainGenerator.h"
-#include "DelaunayHelper.h"
-#include "FPoissonSampling.h"
 #include "MapNode.h"
 #include "NodeEdge.h"
+#include "SVoronoiMapView.h"
+#include "Engine/Texture2D.h"
+#include "Widgets/SOverlay.h"
+#include "Widgets/SInvalidationPanel.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
 
 void UMapGeneration::NativeConstruct()
 {
 	Super::NativeConstruct();
 
-	// Construct TerrainGenerator here
-	TerrainGen = NewObject<UTerrainGenerator>(this, UTerrainGenerator::StaticClass());
-	TerrainGen->MapGen = this;
+	InitializeModules();
+}
+
+void UMapGeneration::NativeDestruct()
+{
+	// Background Work Must Not Outlive the Widget
+	CancelGeneration();
+
+	Super::NativeDestruct();
+}
+
+void UMapGeneration::NativeTick(const FGeometry& MyGeometry, const float InDeltaTime)
+{
+	Super::NativeTick(MyGeometry, InDeltaTime);
+
+	if (ActiveTask)
+	{
+		TickGeneration();
+	}
+
+	// Stream Chunks as the Viewport Moves
+	if (bChunkedWorld && !Chunks.IsEmpty() && GetDesiredChunkRect() != ResidentChunkRect)
+	{
+		UpdateResidentChunks();
+	}
+
+	// Collect Node & Edge Changes Into the Batches Before They're Painted
+	if (bCellBatchDirty)
+	{
+		RebuildCellBatch();
+		InvalidateMap();
+	}
+	else if (bEdgeBatchDirty)
+	{
+		RebuildEdgeBatch();
+		InvalidateMap();
+	}
+
+	// Pixels Drawn Before the Map Last Changed are Dropped & Drawn Again
+	if (PendingRaster.IsValid() && PendingRaster.IsReady())
+	{
+		if (!bRasterDirty && bRasterHasEdges == bDrawVoronoiEdges)
+		{
+			UploadRaster(PendingRaster.Get());
+			InvalidateMap();
+		}
+		PendingRaster.Reset();
+	}
+
+	// The Texture is Only Redone While Zoomed Out Enough to Show it
+	if (!PendingRaster.IsValid() && (bRasterDirty || bRasterHasEdges != bDrawVoronoiEdges) && ShouldPaintRaster(MyGeometry))
+	{
+		RebuildRaster();
+		InvalidateMap();
+	}
 }
 
 //////////////////
 //  Event Logic //
 //////////////////
 
-int32 UMapGeneration::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+TSharedRef<SWidget> UMapGeneration::RebuildWidget()
 {
-	for (const UMapNode* Node : Nodes)
-	{
-		Node->NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId - 2, InWidgetStyle, bParentEnabled);
-	}
+	MapView = SNew(SVoronoiMapView)
+		.Map(this)
+		.Visibility(EVisibility::HitTestInvisible);
 
-	// Decrement the LayerId for UMapGeneration
-	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId - 1, InWidgetStyle, bParentEnabled);
+	// The Panel Replays the View's Last Paint Until InvalidateMap Invalidates the View
+	return SNew(SOverlay)
+		+ SOverlay::Slot()
+		[
+			SNew(SInvalidationPanel)
+			[
+				MapView.ToSharedRef()
+			]
+		]
+		+ SOverlay::Slot()
+		[
+			Super::RebuildWidget()
+		];
 }
 
-FReply UMapGeneration::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+void UMapGeneration::ReleaseSlateResources(const bool bReleaseChildren)
 {
-	for (UMapNode* Node : Nodes)
-	{
-		Node->NativeOnMouseMove(InGeometry, InMouseEvent);
-	}
+	Super::ReleaseSlateResources(bReleaseChildren);
 
-	return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
+	MapView.Reset();
 }
 
-FReply UMapGeneration::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+// The View Sits Under its Own Invalidation Panel, so it's Invalidated Separately From the Widget
+void UMapGeneration::InvalidateMap()
 {
-	for (UMapNode* Node : Nodes)
+	Super::InvalidateMap();
+
+	if (MapView)
 	{
-		Node->NativeOnMouseButtonDown(InGeometry, InMouseEvent);
+		MapView->Invalidate(EInvalidateWidgetReason::Paint);
 	}
-
-	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
 }
 
-FReply UMapGeneration::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
+FReply UMapGeneration::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
 {
-	for (UMapNode* Node : Nodes)
+	// Only the Node Under the Cursor is Selected, the Map View Never Takes Input
+	if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton)
 	{
-		Node->NativeOnMouseButtonUp(InGeometry, InMouseEvent);
+		const FVector2D LocalPoint = InGeometry.AbsoluteToLocal(InMouseEvent.GetScreenSpacePosition());
+		if (UMapNode* Node = FindNodeUnderPoint(TranslateToVirtualSpace(LocalPoint)))
+		{
+			SetSelectedNode(Node);
+		}
 	}
 
-	return Super::NativeOnMouseButtonUp(InGeometry, InMouseEvent);
+	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
 }
 
 ////////////////////
@@ -70,22 +139,224 @@ FReply UMapGeneration::NativeOnMouseButtonUp(const FGeometry& InGeometry, const
 
 void UMapGeneration::GenerateMap()
 {
+	// A Synchronous Request Supersedes Any Generation in Flight
+	CancelGeneration();
+	InitializeModules();
+
+	// Chunks Around the Viewport Replace the Bounded Map
+	if (bChunkedWorld)
+	{
+		RecycleGraph();
+		AppliedGraphHash = MakeGraphSettings().GetParameterHash();
+		return UpdateResidentChunks();
+	}
+
+	const FMapGraphSettings Settings = MakeGraphSettings();
+	FMapGraphData Graph;
+	FMapGraphBuilder::Build(Settings, Graph);
+
+	ApplyGraph(Settings, Graph);
+}
+
+/**
+ * Turns Graph Data Into the Full Map, Meshes First Then Terrain & Biomes
+ * Doesn't depend on the widget being constructed, so maps can be generated headless
+ * @param Settings Parameters the Graph Was Built With
+ * @param Graph Result of the Pure Data Stages
+ */
+void UMapGeneration::ApplyGraph(const FMapGraphSettings& Settings, FMapGraphData& Graph)
+{
+	InitializeModules();
+
 	// Build Base Map
-	GenerateGraph();
+	GenerateGraph(Graph);
+	AppliedGraphHash = Settings.GetParameterHash();
 
 	// Build Terrain & Biomes
-	TerrainGen->GenerateTerrain();
+	RunTerrainStages(EMapDirtyStage::All);
+}
+
+/// Creates Generator Modules That Don't Exist Yet
+void UMapGeneration::InitializeModules()
+{
+	if (!TerrainGen)
+	{
+		TerrainGen = NewObject<UTerrainGenerator>(this, UTerrainGenerator::StaticClass());
+		TerrainGen->MapGen = this;
+	}
+}
+
+/**
+ * Runs Points, Delaunay & Graph Stages on a Background Task,
+ * Mesh & Terrain are Applied on the Game Thread Once the Task Completes
+ */
+void UMapGeneration::GenerateMapAsync()
+{
+	// Chunks are Small Enough to Build Synchronously as They Stream in
+	if (bChunkedWorld)
+	{
+		return GenerateMap();
+	}
+
+	CancelGeneration();
+
+	ActiveTask = MakeShared<FMapGenerationTask, ESPMode::ThreadSafe>();
+	ActiveTask->Settings = MakeGraphSettings();
+	BroadcastProgress(EMapGenerationStage::Points);
+
+	// The Task Only Sees the Settings Snapshot & its Own State, Never the Widget
+	TSharedPtr<FMapGenerationTask, ESPMode::ThreadSafe> Task = ActiveTask;
+	PendingGraphResult = Async(EAsyncExecution::ThreadPool, [Task]()
+	{
+		return FMapGraphBuilder::Build(Task->Settings, Task->Graph, Task.Get());
+	});
+}
+
+/**
+ * Compares Current Parameters With the Ones Each Stage Last Ran With,
+ * Only Stages Downstream of a Change are Re-Run
+ */
+void UMapGeneration::RegenerateMap()
+{
+	InitializeModules();
+	EMapDirtyStage Stages = DirtyStages | GetChangedStages();
+
+	// A New Graph Invalidates Everything Built on it
+	if (EnumHasAnyFlags(Stages, EMapDirtyStage::Graph) || Nodes.IsEmpty())
+	{
+		return GenerateMap();
+	}
+
+	// Land Decides Which Nodes & Edges Cliffs and Biomes Work on
+	if (EnumHasAnyFlags(Stages, EMapDirtyStage::Land))
+	{
+		Stages |= EMapDirtyStage::Cliffs | EMapDirtyStage::Biomes;
+	}
+
+	RunTerrainStages(Stages);
+}
+
+// Stops the Background Task at its Next Checkpoint & Discards its Result
+void UMapGeneration::CancelGeneration()
+{
+	if (!ActiveTask)
+	{
+		return;
+	}
+
+	ActiveTask->bCancelRequested = true;
+	ActiveTask.Reset();
+	PendingGraphResult.Reset();
+
+	OnGenerationFinished.Broadcast(false);
+}
+
+/**
+ * Builds Chunks That Came Within ChunkLoadRadius of the Viewport & Releases Ones That Left it,
+ * Released Nodes & Edges Go Back to the Pools so Memory Stays Bounded by the Resident Area
+ */
+void UMapGeneration::UpdateResidentChunks()
+{
+	if (!bChunkedWorld)
+	{
+		return;
+	}
+
+	const FIntRect DesiredRect = GetDesiredChunkRect();
+	ResidentChunkRect = DesiredRect;
+
+	// Unload Chunks Outside the Desired Range
+	bool bUnloadedChunk = false;
+	for (auto It = Chunks.CreateIterator(); It; ++It)
+	{
+		if (DesiredRect.Contains(It.Key()))
+		{
+			continue;
+		}
+
+		for (UMapNode* Node : It.Value().Nodes)
+		{
+			if (Node == SelectedNode)
+			{
+				SelectedNode = nullptr;
+			}
+			MarkNodeForRemoval(Node);
+		}
+
+		It.RemoveCurrent();
+		bUnloadedChunk = true;
+	}
+
+	if (bUnloadedChunk)
+	{
+		ProcessInvalidNodes();
+	}
+
+	// Load Missing Chunks, Each One Independent of What's Already Resident
+	const FMapGraphSettings Settings = MakeGraphSettings();
+	const int32 FirstLoadedNode = Nodes.Num();
+	TArray<FIntPoint> LoadedChunks;
+	for (int32 Y = DesiredRect.Min.Y; Y < DesiredRect.Max.Y; ++Y)
+	{
+		for (int32 X = DesiredRect.Min.X; X < DesiredRect.Max.X; ++X)
+		{
+			const FIntPoint Chunk(X, Y);
+			if (Chunks.Contains(Chunk))
+			{
+				continue;
+			}
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::BuildChunk(Settings, Chunk, Graph);
+
+			const int32 FirstNewNode = Nodes.Num();
+			AppendGraph(Graph);
+
+			FMapChunk& NewChunk = Chunks.Add(Chunk);
+			NewChunk.Nodes.Append(Nodes.GetData() + FirstNewNode, Nodes.Num() - FirstNewNode);
+			LoadedChunks.Add(Chunk);
+		}
+	}
+
+	// Noise is Sampled in World Space, so Terrain Continues Seamlessly Across Chunks
+	if (!LoadedChunks.IsEmpty())
+	{
+		// Resident Chunks Keep Their Terrain Unless Parameters Changed Since it Ran
+		if (FirstLoadedNode == 0 || DirtyStages != EMapDirtyStage::None || GetChangedStages() != EMapDirtyStage::None)
+		{
+			RunTerrainStages(EMapDirtyStage::All);
+		}
+		else
+		{
+			TerrainGen->GenerateChunkTerrain(FirstLoadedNode);
+
+			// Each Chunk Has its Own Pyramid, Only the New Ones Need Building
+			if (bUseLODPyramid)
+			{
+				for (const FIntPoint& Chunk : LoadedChunks)
+				{
+					RefreshChunkPyramid(Chunk, Chunks[Chunk]);
+				}
+			}
+			InvalidateMap();
+		}
+	}
+	else if (bUnloadedChunk)
+	{
+		// Unloaded Pyramids Left With Their Chunks
+		InvalidateMap();
+	}
 }
 
 /**
- * Adds Invalid Nodes to Array
+ * Flags Invalid Node, Removed During the Next Compaction Pass
  * @param Node Invalid Node
  */
 void UMapGeneration::MarkNodeForRemoval(UMapNode* Node)
 {
-	if (Node && !InvalidNodes.Contains(Node))
+	if (Node)
 	{
-		InvalidNodes.Add(Node);
+		Node->MarkForRemoval();
 	}
 }
 
@@ -106,187 +377,1057 @@ void UMapGeneration::SetSelectedNode(UMapNode* Node)
 		// Set the new selected node
 		Node->Selected();
 		SelectedNode = Node;
+		InvalidateMap();
 	}
 }
 
-////////////////////////////
-// Map Generation Methods //
-////////////////////////////
+void UMapGeneration::SetDrawVoronoiEdges(const bool bInDrawVoronoiEdges)
+{
+	if (bDrawVoronoiEdges != bInDrawVoronoiEdges)
+	{
+		bDrawVoronoiEdges = bInDrawVoronoiEdges;
+		InvalidateMap();
+	}
+}
+
+void UMapGeneration::SetDrawDelaunayTriangles(const bool bInDrawDelaunayTriangles)
+{
+	if (bDrawDelaunayTriangles != bInDrawDelaunayTriangles)
+	{
+		bDrawDelaunayTriangles = bInDrawDelaunayTriangles;
+		InvalidateMap();
+	}
+}
 
-/// Main Method For Map Generation
-void UMapGeneration::GenerateGraph()
+void UMapGeneration::SetDrawVoronoiCentroids(const bool bInDrawVoronoiCentroids)
 {
-	Nodes.Empty();
+	if (bDrawVoronoiCentroids != bInDrawVoronoiCentroids)
+	{
+		bDrawVoronoiCentroids = bInDrawVoronoiCentroids;
+		InvalidateMap();
+	}
+}
 
-	const TArray<FVector2D> Points = GeneratePoints();
+// Builds or Releases the Pyramid Straight Away, it's Otherwise Only Refreshed When Terrain Runs
+void UMapGeneration::SetUseLODPyramid(const bool bInUseLODPyramid)
+{
+	if (bUseLODPyramid != bInUseLODPyramid)
+	{
+		bUseLODPyramid = bInUseLODPyramid;
+		RefreshPyramid();
+	}
+}
 
-	// Generate Delaunay triangulation
-	const FDelaunayMesh DelaunayMesh = UDelaunayHelper::CreateDelaunayTriangulation(Points);
+void UMapGeneration::SetMinLODCellPixels(const float InMinLODCellPixels)
+{
+	if (MinLODCellPixels != InMinLODCellPixels)
+	{
+		MinLODCellPixels = InMinLODCellPixels;
+		InvalidateMap();
+	}
+}
 
-	// Dual Graph Generation
-	RelateGraph(DelaunayMesh, Points);
+// Tiles Keep the Tessellation of the Band They Were Built at, so Every Tile is Rebuilt at its Next Paint
+void UMapGeneration::SetMinCurveSegmentPixels(const float InMinCurveSegmentPixels)
+{
+	if (MinCurveSegmentPixels != InMinCurveSegmentPixels)
+	{
+		MinCurveSegmentPixels = InMinCurveSegmentPixels;
+		for (FMapMeshTile& Tile : CellTiles)
+		{
+			Tile.FillBand = MIN_int32;
+			Tile.LinesBand = MIN_int32;
+		}
+		InvalidateMap();
+	}
+}
 
-	// Try To Build Mesh, Remove Nodes Out of Bounds, And Clip Nodes in Bounds
-	for (const auto& Node : Nodes)
+void UMapGeneration::SetUseRasterCache(const bool bInUseRasterCache)
+{
+	if (bUseRasterCache != bInUseRasterCache)
 	{
-		Node->BuildMesh();
+		bUseRasterCache = bInUseRasterCache;
+		InvalidateMap();
 	}
+}
 
-	ProcessInvalidNodes();
+// Texel Density Comes From the Tile Bounds, Rebucketing the Tiles Recomputes it & Redoes the Texture
+void UMapGeneration::SetRasterResolution(const int32 InRasterResolution)
+{
+	if (RasterResolution != InRasterResolution)
+	{
+		RasterResolution = InRasterResolution;
+		bCellBatchDirty = true;
+		InvalidateMap();
+	}
+}
+
+/**
+ * Jumps to the Nearest Centroid Through the Site Index, Then Walks to its Neighbors if Needed
+ * Curved edges bow across the straight Voronoi border, so a point near it can lie in the neighbor's drawn cell
+ * @param Point Point in Map Space
+ * @return Node Containing the Point, Null Outside the Map
+ */
+UMapNode* UMapGeneration::FindNodeUnderPoint(const FVector2D& Point) const
+{
+	UMapNode* Nearest = FindNodeAt(Point);
+	if (!Nearest)
+	{
+		return nullptr;
+	}
+
+	if (Nearest->IsInNode(Point))
+	{
+		return Nearest;
+	}
+
+	for (UMapNode* Neighbor : Nearest->Neighbors)
+	{
+		if (Neighbor->IsInNode(Point))
+		{
+			return Neighbor;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * A Point Lies in the Voronoi Cell of its Nearest Site, so This is a Single Nearest Centroid Query
+ * @param Point Point in Map Space
+ * @return Node Owning the Point, Null if the Map is Empty
+ */
+UMapNode* UMapGeneration::FindNodeAt(const FVector2D Point) const
+{
+	const int32 NearestIndex = SiteIndex.FindNearest(Point);
+	return NearestIndex != INDEX_NONE ? Nodes[NearestIndex] : nullptr;
 }
 
-// Creates a Poisson Distribution of Points Based on MapSize
-TArray<FVector2D> UMapGeneration::GeneratePoints() const
+/**
+ * Nearest Nodes by Centroid, Suited to AI & Pathing Queries Around a World Position
+ * @param Point Point in Map Space
+ * @param Count Number of Nodes Wanted
+ * @return Up to Count Nodes, Nearest First
+ */
+TArray<UMapNode*> UMapGeneration::FindKNearest(const FVector2D Point, const int32 Count) const
 {
-	// Setup the random stream
-	FRandomStream RandomStream;
-	RandomStream.GenerateNewSeed();
+	TArray<int32> NearestIndices;
+	SiteIndex.FindKNearest(Point, Count, NearestIndices);
 
-	// Call the Poisson Disk Sampling function with Spacing parameter
-	return FPoissonSampling::GeneratePoissonDiscSamples(MapSize.X + BoundaryOffset.X, MapSize.Y + BoundaryOffset.Y, Spacing, K, Iterations, RandomStream);
+	TArray<UMapNode*> NearestNodes;
+	NearestNodes.Reserve(NearestIndices.Num());
+	for (const int32 Index : NearestIndices)
+	{
+		NearestNodes.Add(Nodes[Index]);
+	}
+	return NearestNodes;
 }
 
+////////////////////////////
+// Map Generation Methods //
+////////////////////////////
+
 /**
- * Relates Graph Data to Structure of Nodes & Edges
- * @param Delaunator Delaunay Graph
- * @param Points Poisson Random Points
+ * Reports Background Progress & Finishes the Pipeline on the Game Thread,
+ * Mesh & Terrain Each Get Their Own Tick so Listeners See a Stage Before its Work Stalls the Frame
  */
-void UMapGeneration::RelateGraph(const FDelaunayMesh& Delaunator, const TArray<FVector2D>& Points)
+void UMapGeneration::TickGeneration()
 {
-	// Map to keep track of unique edges using triangle index pairs as keys.
-	TMap<TPair<FTriangleIndex, FTriangleIndex>, UNodeEdge*> UniqueEdgesMap;
+	if (ActiveTask->Stage != LastReportedStage)
+	{
+		BroadcastProgress(ActiveTask->Stage);
 
-	// A mapping from point indices to their corresponding Voronoi nodes (UMapNode instances).
-	TMap<FPointIndex, UMapNode*> PointIndexToNodeMap;
+		// Listeners May Cancel
+		if (!ActiveTask)
+		{
+			return;
+		}
+	}
 
-	// Step 1: Create Voronoi nodes for each point in the original set.
-	for (int32 i = 0; i < Points.Num(); ++i)
+	// Meshes Were Built Last Tick
+	if (ActiveTask->Stage == EMapGenerationStage::Terrain)
 	{
-		FPointIndex PointIndex(i);
-		FVector2D Point = Points[i] - (BoundaryOffset / 2);
+		ActiveTask.Reset();
+		RunTerrainStages(EMapDirtyStage::All);
 
-		UMapNode* Node = NewObject<UMapNode>(this, UMapNode::StaticClass());
-		Node->SetupNode(this, Point);
-		Nodes.Add(Node);
-		PointIndexToNodeMap.Add(PointIndex, Node);
+		BroadcastProgress(EMapGenerationStage::Complete);
+		OnGenerationFinished.Broadcast(true);
+		return;
 	}
 
-	// Step 2: Establish edges and associate them with the Voronoi nodes.
-	for (FSideIndex SideIndex = 0; SideIndex.Value < Delaunator.HalfEdges.Num(); ++SideIndex)
+	// Graph Finished Last Tick
+	if (ActiveTask->Stage == EMapGenerationStage::Mesh)
 	{
-		if (!SideIndex.IsValid())
-			continue;
+		InitializeModules();
+		GenerateGraph(ActiveTask->Graph);
+		AppliedGraphHash = ActiveTask->Settings.GetParameterHash();
 
-		FSideIndex OppositeEdgeIndex = UDelaunayHelper::OppositeHalfEdge(Delaunator, SideIndex);
-		if (!OppositeEdgeIndex.IsValid())
-			continue;
+		// A Cancel Before Terrain Runs Leaves it for the Next Regenerate
+		DirtyStages = EMapDirtyStage::All;
+		ActiveTask->SetStage(EMapGenerationStage::Terrain);
+		BroadcastProgress(EMapGenerationStage::Terrain);
+		return;
+	}
 
-		// Get the triangles on either side of this edge
-		FTriangleIndex CurrentTriangleIndex = UDelaunayHelper::GetTriangleIndexFromHalfEdge(SideIndex);
-		FTriangleIndex AdjacentTriangleIndex = UDelaunayHelper::GetTriangleIndexFromHalfEdge(OppositeEdgeIndex);
+	if (!PendingGraphResult.IsReady())
+	{
+		return;
+	}
 
-		// Use the sorted pair of triangle indices to check for unique edges
-		TPair<FTriangleIndex, FTriangleIndex> SortedTrianglePair(
-			FMath::Min(CurrentTriangleIndex, AdjacentTriangleIndex),
-			FMath::Max(CurrentTriangleIndex, AdjacentTriangleIndex)
-		);
+	const bool bCompleted = PendingGraphResult.Get();
+	PendingGraphResult.Reset();
 
-		UNodeEdge* Edge = nullptr;
+	if (!bCompleted)
+	{
+		ActiveTask.Reset();
+		OnGenerationFinished.Broadcast(false);
+		return;
+	}
 
-		// Check if this edge has already been created
-		if (UniqueEdgesMap.Contains(SortedTrianglePair))
-		{
-			Edge = UniqueEdgesMap[SortedTrianglePair];
-		}
-		else
-		{
-			// Create the edge and add it to the map
-			FVector2D CircumcenterCurrent = UDelaunayHelper::GetTriangleCircumcenter(
-				UDelaunayHelper::ConvertTriangleIDToTriangle(Delaunator, CurrentTriangleIndex)
-			) - (BoundaryOffset / 2);
+	ActiveTask->SetStage(EMapGenerationStage::Mesh);
+	BroadcastProgress(EMapGenerationStage::Mesh);
+}
 
-			FVector2D CircumcenterAdjacent = UDelaunayHelper::GetTriangleCircumcenter(
-				UDelaunayHelper::ConvertTriangleIDToTriangle(Delaunator, AdjacentTriangleIndex)
-			) - (BoundaryOffset / 2);
+void UMapGeneration::BroadcastProgress(const EMapGenerationStage Stage)
+{
+	LastReportedStage = Stage;
+	OnGenerationProgress.Broadcast(Stage, FMapGenerationTask::GetStageProgress(Stage));
+}
 
-			Edge = NewObject<UNodeEdge>(this, UNodeEdge::StaticClass());
-			Edge->SetupEdge(CircumcenterCurrent, CircumcenterAdjacent, this);
+// Stages Whose Parameters Differ From the Ones They Last Ran With
+EMapDirtyStage UMapGeneration::GetChangedStages() const
+{
+	EMapDirtyStage Stages = EMapDirtyStage::None;
 
-			UniqueEdgesMap.Add(SortedTrianglePair, Edge);
-		}
+	if (MakeGraphSettings().GetParameterHash() != AppliedGraphHash) Stages |= EMapDirtyStage::Graph;
+	if (TerrainGen->GetLandParameterHash() != AppliedLandHash) Stages |= EMapDirtyStage::Land;
+	if (TerrainGen->GetCliffParameterHash() != AppliedCliffHash) Stages |= EMapDirtyStage::Cliffs;
+	if (TerrainGen->GetBiomeParameterHash() != AppliedBiomeHash) Stages |= EMapDirtyStage::Biomes;
 
-		// Check if the current and adjacent triangles share a common vertex with the node's original point
-		TArray<FPointIndex> CurrentTrianglePoints = UDelaunayHelper::PointsOfTriangle(Delaunator, CurrentTriangleIndex);
-		TArray<FPointIndex> AdjacentTrianglePoints = UDelaunayHelper::PointsOfTriangle(Delaunator, AdjacentTriangleIndex);
+	return Stages;
+}
 
-		for (FPointIndex PointIndex : CurrentTrianglePoints)
-		{
-			if (AdjacentTrianglePoints.Contains(PointIndex)) // This check ensures both triangles share this vertex
-			{
-				UMapNode* Node = PointIndexToNodeMap[PointIndex];
-				if (Node && !Node->Edges.Contains(Edge))
-				{
-					Node->AddEdge(Edge);
-
-					// Add each node as a neighbor to each other if not already neighbors
-					for (FPointIndex OtherPointIndex : CurrentTrianglePoints)
-					{
-						if (OtherPointIndex != PointIndex)
-						{
-							UMapNode* OtherNode = PointIndexToNodeMap[OtherPointIndex];
-							if (OtherNode && !Node->Neighbors.Contains(OtherNode))
-							{
-								Node->AddNeighbor(OtherNode);
-							}
-						}
-					}
-
-					for (FPointIndex OtherPointIndex : AdjacentTrianglePoints)
-					{
-						if (OtherPointIndex != PointIndex)
-						{
-							UMapNode* OtherNode = PointIndexToNodeMap[OtherPointIndex];
-							if (OtherNode && !Node->Neighbors.Contains(OtherNode))
-							{
-								Node->AddNeighbor(OtherNode);
-							}
-						}
-					}
-				}
-			}
-		}
+/**
+ * Runs Terrain Stages in Pipeline Order & Records the Parameters They Ran With
+ * @param Stages Stages to Run
+ */
+void UMapGeneration::RunTerrainStages(const EMapDirtyStage Stages)
+{
+	if (EnumHasAnyFlags(Stages, EMapDirtyStage::Land))
+	{
+		TerrainGen->GenerateLand();
+		AppliedLandHash = TerrainGen->GetLandParameterHash();
+	}
+
+	if (EnumHasAnyFlags(Stages, EMapDirtyStage::Cliffs))
+	{
+		TerrainGen->GenerateCliffs();
+		AppliedCliffHash = TerrainGen->GetCliffParameterHash();
+	}
 
+	if (EnumHasAnyFlags(Stages, EMapDirtyStage::Biomes))
+	{
+		TerrainGen->GenerateBiomes();
+		AppliedBiomeHash = TerrainGen->GetBiomeParameterHash();
 	}
+
+	DirtyStages = EMapDirtyStage::None;
+
+	// Coarse Levels Average the Colors Terrain Just Assigned
+	RefreshPyramid();
 }
 
-// Remove Invalid Nodes from Array
-void UMapGeneration::ProcessInvalidNodes()
+// Snapshot of Parameters Handed to the Graph Builder
+FMapGraphSettings UMapGeneration::MakeGraphSettings() const
+{
+	FMapGraphSettings Settings;
+	Settings.MapSize = MapSize;
+	Settings.BoundaryOffset = BoundaryOffset;
+	Settings.Iterations = Iterations;
+	Settings.K = K;
+	Settings.Spacing = Spacing;
+	Settings.Seed = bChunkedWorld ? WorldSeed : FMath::Rand();
+	Settings.bChunked = bChunkedWorld;
+	Settings.ChunkSize = ChunkSize;
+	Settings.bParallel = bParallelGeneration;
+	return Settings;
+}
+
+/**
+ * Main Method For Map Generation, Turns Graph Data Into Nodes & Edges
+ * @param Graph Result of the Pure Data Stages
+ */
+void UMapGeneration::GenerateGraph(FMapGraphData& Graph)
+{
+	RecycleGraph();
+	AppendGraph(Graph);
+}
+
+/**
+ * Adds Graph Data to the Nodes & Edges Already in the Map, Only New Nodes Build Meshes
+ * @param Graph Result of the Pure Data Stages
+ */
+void UMapGeneration::AppendGraph(FMapGraphData& Graph)
 {
-	TArray<UNodeEdge*> EdgesToRemove;
+	const int32 FirstNewNode = Nodes.Num();
+
+	// Dual Graph Generation
+	RelateGraph(Graph);
 
-	// Process nodes for removal
-	for (UMapNode* Node : InvalidNodes)
+	// Try To Build Mesh, Each Node Flags Itself if it's Out of Bounds
+	ParallelFor(Nodes.Num() - FirstNewNode, [this, FirstNewNode](const int32 Index)
 	{
-		for (UNodeEdge* Edge : Node->Edges)
+		UMapNode* Node = Nodes[FirstNewNode + Index];
+		if (!Node->BuildMesh())
 		{
-			Edge->Nodes.Remove(Node);
-			if (Edge->Nodes.Num() == 0)
-			{
-				EdgesToRemove.AddUnique(Edge);
-			}
+			MarkNodeForRemoval(Node);
 		}
+	}, FMapGraphBuilder::GetParallelFlags(bParallelGeneration));
 
-		for (UMapNode* Neighbor : Node->Neighbors)
-		{
-			Neighbor->Neighbors.Remove(Node);
-		}
-	}
+	// Remove Nodes Out of Bounds
+	ProcessInvalidNodes();
+}
 
-	// Remove edges and nodes
-	for (UMapNode* Node : InvalidNodes)
+/**
+ * Relates Graph Data to Structure of Nodes & Edges, Appended After Existing Ones
+ * UObjects are allocated on the game thread, filling them in is spread across workers
+ * @param Graph Result of the Pure Data Stages
+ */
+void UMapGeneration::RelateGraph(FMapGraphData& Graph)
+{
+	const EParallelForFlags ParallelFlags = FMapGraphBuilder::GetParallelFlags(bParallelGeneration);
+	const int32 NodeOffset = Nodes.Num();
+	const int32 EdgeOffset = Edges.Num();
+	const int32 VertexOffset = Vertices.Num();
+
+	// Vertices are Shared, Edges Only Store Their Indices
+	Vertices.Append(Graph.Vertices);
+
+	// Curves Keep the Graph's Edge Order, so Each Edge's Range Only Shifts by a Constant
+	const int32 CurveOffset = CurvePoints.Num();
+	CurvePoints.Append(Graph.CurvePoints);
+
+	// Step 1: Create Voronoi nodes for each site, only allocating what the pool can't cover.
+	Nodes.SetNum(NodeOffset + Graph.Sites.Num());
+	for (int32 Index = NodeOffset; Index < Nodes.Num(); ++Index)
+	{
+		Nodes[Index] = NodePool.IsEmpty() ? NewObject<UMapNode>(this, UMapNode::StaticClass()) : NodePool.Pop(false);
+	}
+
+	// Step 2: Create Voronoi edges, only allocating what the pool can't cover.
+	Edges.SetNum(EdgeOffset + Graph.Edges.Num());
+	EdgeNodes.SetNum(EdgeOffset + Graph.Edges.Num());
+	for (int32 Index = EdgeOffset; Index < Edges.Num(); ++Index)
+	{
+		Edges[Index] = EdgePool.IsEmpty() ? NewObject<UNodeEdge>(this, UNodeEdge::StaticClass()) : EdgePool.Pop(false);
+	}
+
+	// Edge Setup Only Touches the Edge Itself, Chunk Seam Edges Only Have One Node
+	ParallelFor(Graph.Edges.Num(), [&](const int32 Index)
+	{
+		FMapGraphEdge& GraphEdge = Graph.Edges[Index];
+
+		UNodeEdge* Edge = Edges[EdgeOffset + Index];
+		Edge->SetupEdge(GraphEdge, VertexOffset, this);
+		Edge->Index = EdgeOffset + Index;
+
+		const int32 NodeA = GraphEdge.NodeA != INDEX_NONE ? NodeOffset + GraphEdge.NodeA : INDEX_NONE;
+		const int32 NodeB = GraphEdge.NodeB != INDEX_NONE ? NodeOffset + GraphEdge.NodeB : INDEX_NONE;
+		EdgeNodes[Edge->Index] = FMapEdgeNodes(NodeA, NodeB);
+
+		Edge->CurveStart = CurveOffset + GraphEdge.CurveStart;
+		Edge->CurveNum = GraphEdge.CurveNum;
+	}, ParallelFlags);
+
+	// Step 3: Relate each node to its edges & neighbors, a node only ever writes to itself.
+	ParallelFor(Graph.Sites.Num(), [&](const int32 Index)
+	{
+		UMapNode* Node = Nodes[NodeOffset + Index];
+		Node->SetupNode(this, Graph.Sites[Index]);
+
+		for (const int32 EdgeIndex : Graph.SiteEdges[Index])
+		{
+			Node->AddEdge(Edges[EdgeOffset + EdgeIndex]);
+		}
+
+		for (const int32 NeighborIndex : Graph.SiteNeighbors[Index])
+		{
+			Node->AddNeighbor(Nodes[NodeOffset + NeighborIndex]);
+		}
+	}, ParallelFlags);
+
+	// Workers Leave the Map's Own State Alone, the New Cells & Edges are Flagged Here
+	bCellBatchDirty = true;
+	bEdgeBatchDirty = true;
+}
+
+// Chunks Within ChunkLoadRadius of the Area the Viewport Covers, Max is Exclusive
+FIntRect UMapGeneration::GetDesiredChunkRect() const
+{
+	const FVector2D ViewMin = (ViewportPosition - ViewportSize / 2) / ChunkSize;
+	const FVector2D ViewMax = (ViewportPosition + ViewportSize / 2) / ChunkSize;
+
+	const FIntPoint Min(FMath::FloorToInt32(ViewMin.X) - ChunkLoadRadius, FMath::FloorToInt32(ViewMin.Y) - ChunkLoadRadius);
+	const FIntPoint Max(FMath::FloorToInt32(ViewMax.X) + ChunkLoadRadius + 1, FMath::FloorToInt32(ViewMax.Y) + ChunkLoadRadius + 1);
+	return FIntRect(Min, Max);
+}
+
+/// Moves the Current Nodes & Edges Into the Pools, Their State is Reset When They are Set Up Again
+void UMapGeneration::RecycleGraph()
+{
+	SelectedNode = nullptr;
+	Chunks.Reset();
+
+	NodePool.Append(Nodes);
+	Nodes.Reset();
+
+	// Pooled Edges Don't Point Into the Tables Anymore
+	for (UNodeEdge* Edge : Edges)
+	{
+		Edge->Index = INDEX_NONE;
+		Edge->CurveStart = INDEX_NONE;
+	}
+
+	EdgePool.Append(Edges);
+	Edges.Reset();
+	EdgeNodes.Reset();
+	Vertices.Reset();
+	CurvePoints.Reset();
+	SiteIndex.Reset();
+	bCellBatchDirty = true;
+
+	if (TerrainGen)
+	{
+		TerrainGen->LandNodes.Reset();
+		TerrainGen->LandEdges.Reset();
+	}
+}
+
+void UMapGeneration::EmptyPools()
+{
+	NodePool.Empty();
+	EdgePool.Empty();
+}
+
+/**
+ * Removes Flagged Nodes From the Graph
+ * Every array is filtered in a single stable pass, so the cost doesn't depend on how many nodes are dropped
+ */
+void UMapGeneration::ProcessInvalidNodes()
+{
+	const EParallelForFlags ParallelFlags = FMapGraphBuilder::GetParallelFlags(bParallelGeneration);
+	const auto IsMarked = [](const UMapNode* Node) { return Node->IsMarkedForRemoval(); };
+
+	// Drop references to flagged nodes, nodes only filter their own arrays
+	ParallelFor(Nodes.Num(), [&](const int32 Index)
+	{
+		if (!Nodes[Index]->IsMarkedForRemoval())
+		{
+			Nodes[Index]->Neighbors.RemoveAll(IsMarked);
+		}
+	}, ParallelFlags);
+
+	// Compact nodes, flagged nodes go back to the pool
+	TArray<int32> NodeRemap;
+	NodeRemap.SetNumUninitialized(Nodes.Num());
+
+	int32 NumNodesKept = 0;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		UMapNode* Node = Nodes[Index];
+		if (Node->IsMarkedForRemoval())
+		{
+			NodePool.Add(Node);
+			NodeRemap[Index] = INDEX_NONE;
+		}
+		else
+		{
+			NodeRemap[Index] = NumNodesKept;
+			Nodes[NumNodesKept++] = Node;
+		}
+	}
+	Nodes.SetNum(NumNodesKept, false);
+
+	// Point edges at the compacted nodes, flagged nodes leave an empty slot
+	ParallelFor(EdgeNodes.Num(), [&](const int32 Index)
+	{
+		FMapEdgeNodes& Pair = EdgeNodes[Index];
+		const int32 NodeA = Pair.Nodes[0] != INDEX_NONE ? NodeRemap[Pair.Nodes[0]] : INDEX_NONE;
+		const int32 NodeB = Pair.Nodes[1] != INDEX_NONE ? NodeRemap[Pair.Nodes[1]] : INDEX_NONE;
+		Pair = FMapEdgeNodes(NodeA, NodeB);
+	}, ParallelFlags);
+
+	// Compact edges, their node pairs & curves together, edges without nodes go back to the pool
+	int32 NumEdgesKept = 0;
+	int32 NumCurvePointsKept = 0;
+	for (int32 Index = 0; Index < Edges.Num(); ++Index)
+	{
+		UNodeEdge* Edge = Edges[Index];
+		if (EdgeNodes[Index].IsEmpty())
+		{
+			Edge->Index = INDEX_NONE;
+			Edge->CurveStart = INDEX_NONE;
+			EdgePool.Add(Edge);
+		}
+		else
+		{
+			FMemory::Memmove(CurvePoints.GetData() + NumCurvePointsKept, CurvePoints.GetData() + Edge->CurveStart, Edge->CurveNum * sizeof(FVector2D));
+			Edge->CurveStart = NumCurvePointsKept;
+			NumCurvePointsKept += Edge->CurveNum;
+
+			Edge->Index = NumEdgesKept;
+			EdgeNodes[NumEdgesKept] = EdgeNodes[Index];
+			Edges[NumEdgesKept++] = Edge;
+		}
+	}
+	Edges.SetNum(NumEdgesKept, false);
+	EdgeNodes.SetNum(NumEdgesKept, false);
+	CurvePoints.SetNum(NumCurvePointsKept, false);
+
+	// Compact the vertex pool down to the vertices kept edges still use
+	TArray<int32> VertexRemap;
+	VertexRemap.Init(INDEX_NONE, Vertices.Num());
+	for (const UNodeEdge* Edge : Edges)
+	{
+		VertexRemap[Edge->VertexA] = 0;
+		VertexRemap[Edge->VertexB] = 0;
+	}
+
+	int32 NumVerticesKept = 0;
+	for (int32 Index = 0; Index < Vertices.Num(); ++Index)
+	{
+		if (VertexRemap[Index] != INDEX_NONE)
+		{
+			VertexRemap[Index] = NumVerticesKept;
+			Vertices[NumVerticesKept++] = Vertices[Index];
+		}
+	}
+	Vertices.SetNum(NumVerticesKept, false);
+
+	ParallelFor(Edges.Num(), [&](const int32 Index)
+	{
+		Edges[Index]->VertexA = VertexRemap[Edges[Index]->VertexA];
+		Edges[Index]->VertexB = VertexRemap[Edges[Index]->VertexB];
+	}, ParallelFlags);
+
+	// Re-Bucket the Surviving Centroids for Point Queries
+	TArray<FVector2D> Sites;
+	Sites.SetNumUninitialized(Nodes.Num());
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Sites[Index] = Nodes[Index]->GetCentroid();
+	}
+	SiteIndex.Build(Sites, Spacing);
+
+	// Terrain Caches Can't Keep Pooled Objects, Their Indices No Longer Match the Tables
+	if (TerrainGen)
+	{
+		TerrainGen->ReleaseRemoved();
+	}
+
+	bPyramidDirty = true;
+	bCellBatchDirty = true;
+}
+
+/// Rebuilds the Pyramid if Nodes Changed, Then Re-Averages its Colors, Chunked Worlds Keep One Pyramid Per Chunk
+void UMapGeneration::RefreshPyramid()
+{
+	// Level Batches Change Whichever Way This Goes
+	InvalidateMap();
+
+	if (!bUseLODPyramid)
+	{
+		Pyramid.Reset();
+		LevelBatches.Reset();
+		bPyramidDirty = true;
+
+		for (TPair<FIntPoint, FMapChunk>& Chunk : Chunks)
+		{
+			Chunk.Value.Pyramid.Reset();
+			Chunk.Value.LevelBatches.Reset();
+		}
+		return;
+	}
+
+	if (bChunkedWorld)
+	{
+		for (TPair<FIntPoint, FMapChunk>& Chunk : Chunks)
+		{
+			RefreshChunkPyramid(Chunk.Key, Chunk.Value);
+		}
+		return;
+	}
+
+	if (bPyramidDirty)
+	{
+		Pyramid.Build(GetCentroids(Nodes), Spacing, bParallelGeneration, FBox2D(FVector2D::ZeroVector, MapSize));
+		bPyramidDirty = false;
+	}
+	UpdateLevelBatches(Nodes, Pyramid, LevelBatches);
+}
+
+/**
+ * Builds a Chunk's Pyramid the First Time it's Refreshed, Clipped to the Chunk so Neighboring Chunks Meet Along its Border,
+ * Later Refreshes Only Re-Average Colors, so Streaming a Chunk in Never Touches the Others
+ * @param Coordinates Chunk Coordinates
+ * @param Chunk Resident Chunk
+ */
+void UMapGeneration::RefreshChunkPyramid(const FIntPoint& Coordinates, FMapChunk& Chunk)
+{
+	if (Chunk.Pyramid.NumLevels() == 0)
+	{
+		// A Chunk Holds Far Fewer Sites Than a Whole Map, Levels Stop Once Too Few Sites are Left to Triangulate
+		Chunk.Pyramid.MinSites = 0;
+
+		const FBox2D ChunkBounds(FVector2D(Coordinates) * ChunkSize, FVector2D(Coordinates + FIntPoint(1, 1)) * ChunkSize);
+		Chunk.Pyramid.Build(GetCentroids(Chunk.Nodes), Spacing, bParallelGeneration, ChunkBounds);
+	}
+	UpdateLevelBatches(Chunk.Nodes, Chunk.Pyramid, Chunk.LevelBatches);
+}
+
+// Centroid of Each Node, the Sites a Pyramid is Built From
+TArray<FVector2D> UMapGeneration::GetCentroids(const TArray<UMapNode*>& PyramidNodes)
+{
+	TArray<FVector2D> Centroids;
+	Centroids.SetNumUninitialized(PyramidNodes.Num());
+	for (int32 Index = 0; Index < PyramidNodes.Num(); ++Index)
+	{
+		Centroids[Index] = PyramidNodes[Index]->GetCentroid();
+	}
+	return Centroids;
+}
+
+/**
+ * Averages Node Colors Up a Pyramid & Rebuilds the Fill of Each Coarse Level
+ * @param PyramidNodes Nodes the Pyramid Was Built From, Index Aligned With its Full Resolution Level
+ * @param LevelPyramid Pyramid to Color
+ * @param OutLevelBatches Fill of Each Level, Index Aligned With Levels
+ */
+void UMapGeneration::UpdateLevelBatches(const TArray<UMapNode*>& PyramidNodes, FMapGraphPyramid& LevelPyramid, TArray<FMapMeshBatch>& OutLevelBatches)
+{
+	TArray<FLinearColor> Colors;
+	Colors.SetNumUninitialized(PyramidNodes.Num());
+	for (int32 Index = 0; Index < PyramidNodes.Num(); ++Index)
+	{
+		Colors[Index] = FLinearColor(PyramidNodes[Index]->GetColor());
+	}
+	LevelPyramid.UpdateColors(Colors);
+
+	// Cells of Each Coarse Level are Convex, so a Fan Triangulates Them
+	const TArray<SlateIndex>& FanIndices = UMapNode::GetFanIndices();
+	OutLevelBatches.SetNum(LevelPyramid.NumLevels());
+	for (int32 Level = 1; Level < LevelPyramid.NumLevels(); ++Level)
+	{
+		const FMapGraphLevel& GraphLevel = LevelPyramid.GetLevel(Level);
+		FMapMeshBatch& Batch = OutLevelBatches[Level];
+		Batch.Reset();
+		Batch.Reserve(GraphLevel.CellVertices.Num(), GraphLevel.CellVertices.Num() * 3);
+
+		for (int32 Cell = 0; Cell < GraphLevel.Num(); ++Cell)
+		{
+			const TArrayView<const FVector2D> Outline = GraphLevel.GetCellVertices(Cell);
+			if (Outline.Num() < 3 || Outline.Num() * 3 > FanIndices.Num() || !GraphLevel.Colors.IsValidIndex(Cell))
+			{
+				continue;
+			}
+
+			// Triangles (0, i, i + 1) With the First Outline Vertex as Hub
+			Batch.AddPolygon(Outline, MakeArrayView(FanIndices.GetData(), (Outline.Num() - 2) * 3), GraphLevel.Colors[Cell].ToFColor(true));
+		}
+	}
+}
+
+/**
+ * Buckets Nodes Into Square Tiles by Centroid, Each Tile's Meshes are Built Into One Buffer Once it's Drawn
+ * A tile's bounds grow to cover every cell in it
+ */
+void UMapGeneration::RebuildCellBatch()
+{
+	const double TileSize = FMath::Max(Spacing, 1) * CellsPerTile;
+
+	CellTiles.Reset();
+	TMap<FIntPoint, int32> TileLookup;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FVector2D Centroid = Nodes[Index]->GetCentroid();
+		const FIntPoint TileCoord(FMath::FloorToInt32(Centroid.X / TileSize), FMath::FloorToInt32(Centroid.Y / TileSize));
+
+		int32& TileIndex = TileLookup.FindOrAdd(TileCoord, INDEX_NONE);
+		if (TileIndex == INDEX_NONE)
+		{
+			TileIndex = CellTiles.AddDefaulted();
+		}
+		CellTiles[TileIndex].Cells.Add(Index);
+	}
+
+	// Fill & Lines are Tessellated When a Tile First Comes Into View at a Zoom Band
+	for (FMapMeshTile& Tile : CellTiles)
+	{
+		Tile.Centroids.Reserve(Tile.Cells.Num());
+		for (const int32 Cell : Tile.Cells)
+		{
+			const UMapNode* Node = Nodes[Cell];
+			Tile.Centroids.AddPoint(Node->GetCentroid(), Node->GetCentroidColor().ToFColor(true), FVector2D(2.0f, 2.0f));
+			Tile.Bounds += Node->GetBounds();
+		}
+	}
+
+	// The Raster Covers Every Tile, Sized so its Longer Side Gets RasterResolution Texels
+	RasterBounds = FBox2D(ForceInit);
+	for (const FMapMeshTile& Tile : CellTiles)
+	{
+		RasterBounds += Tile.Bounds;
+	}
+	RasterTexelsPerUnit = RasterBounds.bIsValid && RasterBounds.GetSize().GetMax() > 0 ? FMath::Max(RasterResolution, 0) / RasterBounds.GetSize().GetMax() : 0.0;
+
+	bCellBatchDirty = false;
+	bRasterDirty = true;
+	RebuildEdgeBatch();
+}
+
+/**
+ * Drops Each Tile's Edge Lines so Visible Tiles Rebuild Them at Their Next Paint, & Collects the Selected Edges
+ * Only the selection is rebuilt here, it's drawn over the raster too
+ */
+void UMapGeneration::RebuildEdgeBatch()
+{
+	for (FMapMeshTile& Tile : CellTiles)
+	{
+		Tile.LinesBand = MIN_int32;
+	}
+
+	SelectionLines.Reset();
+	for (const UNodeEdge* Edge : Edges)
+	{
+		if (Edge->SelectionState == ESelectionState::Selected)
+		{
+			SelectionLines.AddLine(Edge->GetCurvePoints(), Edge->Color.ToFColor(true));
+		}
+	}
+
+	bEdgeBatchDirty = false;
+}
+
+/**
+ * Fills a Tile's Batch With its Cells, Fan Cells Follow Each Edge's LOD for the Band
+ * Vertices carry the node's color, ear clipped cells keep their full mesh
+ * @param Tile Tile to Build
+ * @param Band Zoom Band the View Draws at
+ */
+void UMapGeneration::BuildTileFill(FMapMeshTile& Tile, const int32 Band) const
+{
+	FMapMeshBatch& Batch = Tile.Fill;
+	Batch.Reset();
+	Tile.FillBand = Band;
+
+	int32 NumVertices = 0;
+	int32 NumIndices = 0;
+	for (const int32 Cell : Tile.Cells)
+	{
+		NumVertices += Nodes[Cell]->GetNumOutlinePoints() + 1;
+		NumIndices += FMath::Max(Nodes[Cell]->GetIndices().Num(), Nodes[Cell]->GetNumOutlinePoints() * 3);
+	}
+	Batch.Reserve(NumVertices, NumIndices);
+
+	TArray<int32, TInlineAllocator<16>> EdgeLODs;
+	TArray<FVector2D, TInlineAllocator<128>> MeshVertices;
+	TArray<SlateIndex> LODIndices;
+	for (const int32 Cell : Tile.Cells)
+	{
+		const UMapNode* Node = Nodes[Cell];
+		if (!Node->SupportsCurveLOD())
+		{
+			Node->GetMeshVertices(MeshVertices);
+			Batch.AddPolygon(MeshVertices, Node->GetIndices(), Node->GetColor());
+			continue;
+		}
+
+		EdgeLODs.Reset();
+		for (const UNodeEdge* Edge : Node->Edges)
+		{
+			EdgeLODs.Add(GetEdgeCurveLOD(Edge, Band));
+		}
+
+		Node->GetMeshVertices(MeshVertices, EdgeLODs);
+		LODIndices.Reset();
+		UMapNode::AppendFanIndices(MeshVertices.Num() - 1, LODIndices);
+		Batch.AddPolygon(MeshVertices, LODIndices, Node->GetColor());
+	}
+}
+
+/**
+ * Collects a Tile's Edges Into its Line Batch, Every Edge is Drawn by the Node in its First Slot
+ * Transparent edges are left out entirely
+ * @param Tile Tile to Build
+ * @param Band Zoom Band the View Draws at
+ */
+void UMapGeneration::BuildTileLines(FMapMeshTile& Tile, const int32 Band) const
+{
+	FMapLineBatch& Lines = Tile.Lines;
+	Lines.Reset();
+	Tile.LinesBand = Band;
+
+	TArray<FVector2D, TInlineAllocator<UNodeEdge::NumBezierPoints>> LinePoints;
+	for (const int32 Cell : Tile.Cells)
+	{
+		const UMapNode* Node = Nodes[Cell];
+		for (const UNodeEdge* Edge : Node->Edges)
+		{
+			if (Edge->GetNode(0) == Node && Edge->Color.A > 0 && !Edge->bIsSeamCopy)
+			{
+				Edge->GetCurvePoints(GetEdgeCurveLOD(Edge, Band), LinePoints);
+				Lines.AddLine(LinePoints, Edge->Color.ToFColor(true));
+			}
+		}
+	}
+}
+
+/**
+ * Part of the Map Visible Through Both the Viewport & the Culling Rect, in Map Space
+ * @param AllottedGeometry Geometry the Map is Painted in
+ * @param CullingRect Culling Rect Slate Paints the Widget With, in Render Space
+ * @return Bounds Geometry Has to Overlap to be Drawn
+ */
+FBox2D UMapGeneration::GetVisibleMapBounds(const FGeometry& AllottedGeometry, const FSlateRect& CullingRect) const
+{
+	const FBox2D ViewportBounds(ViewportPosition - ViewportSize / 2, ViewportPosition + ViewportSize / 2);
+
+	// Corners of the culling rect bound it in map space, even if a parent rotates the widget
+	const FSlateRenderTransform RenderToMap = GetMapToRenderTransform(AllottedGeometry).Inverse();
+	FBox2D CullingBounds(ForceInit);
+	CullingBounds += FVector2D(RenderToMap.TransformPoint(FVector2f(CullingRect.GetTopLeft())));
+	CullingBounds += FVector2D(RenderToMap.TransformPoint(FVector2f(CullingRect.GetTopRight())));
+	CullingBounds += FVector2D(RenderToMap.TransformPoint(FVector2f(CullingRect.GetBottomLeft())));
+	CullingBounds += FVector2D(RenderToMap.TransformPoint(FVector2f(CullingRect.GetBottomRight())));
+
+	return CullingBounds.Intersect(ViewportBounds) ? CullingBounds.Overlap(ViewportBounds) : FBox2D(ForceInit);
+}
+
+/**
+ * Physical Pixels a Map Unit Covers, Includes the DPI Scale so Every Pixel Threshold Means the Same on Any Display
+ * @param AllottedGeometry Geometry the Map is Painted in
+ * @return 0 When There is no Viewport Yet
+ */
+double UMapGeneration::GetPixelsPerUnit(const FGeometry& AllottedGeometry) const
+{
+	return ViewportSize.X > 0 ? AllottedGeometry.GetLocalSize().X / ViewportSize.X * AllottedGeometry.Scale : 0.0;
+}
+
+/**
+ * Picks the Finest Pyramid Level Whose Cells Still Cover MinLODCellPixels on Screen
+ * @param AllottedGeometry Geometry the Map is Painted in
+ * @return 0 When Nodes Should be Drawn Directly
+ */
+int32 UMapGeneration::GetPaintLevel(const FGeometry& AllottedGeometry) const
+{
+	if (!bUseLODPyramid || ViewportSize.X <= 0)
+	{
+		return 0;
+	}
+
+	// Level Cell Sizes Only Depend on Spacing, Chunks are Held to the Levels Every Resident Chunk Has
+	const FMapGraphPyramid* LevelPyramid = &Pyramid;
+	int32 NumLevels = Pyramid.NumLevels();
+	if (bChunkedWorld)
+	{
+		NumLevels = Chunks.IsEmpty() ? 0 : MAX_int32;
+		for (const TPair<FIntPoint, FMapChunk>& Chunk : Chunks)
+		{
+			LevelPyramid = &Chunk.Value.Pyramid;
+			NumLevels = FMath::Min(NumLevels, LevelPyramid->NumLevels());
+		}
+	}
+
+	const double PixelsPerUnit = GetPixelsPerUnit(AllottedGeometry);
+	if (NumLevels < 2 || PixelsPerUnit <= 0)
 	{
-		Nodes.Remove(Node);
+		return 0;
+	}
+	return FMath::Min(LevelPyramid->GetLevelForCellSize(MinLODCellPixels / PixelsPerUnit), NumLevels - 1);
+}
+
+/**
+ * Visits the Fill of a Pyramid Level, One Batch per Chunk in a Chunked World
+ * @param Level Level Picked by GetPaintLevel
+ * @param Visitor Called With Each Batch
+ */
+void UMapGeneration::ForEachLevelBatch(const int32 Level, TFunctionRef<void(const FMapMeshBatch&)> Visitor) const
+{
+	if (!bChunkedWorld)
+	{
+		if (LevelBatches.IsValidIndex(Level))
+		{
+			Visitor(LevelBatches[Level]);
+		}
+		return;
+	}
+
+	for (const TPair<FIntPoint, FMapChunk>& Chunk : Chunks)
+	{
+		if (Chunk.Value.LevelBatches.IsValidIndex(Level))
+		{
+			Visitor(Chunk.Value.LevelBatches[Level]);
+		}
+	}
+}
+
+/**
+ * Copies Every Node's Mesh & Every Visible Edge, Then Rasterizes Them on a Worker
+ * The copy is cheap next to filling millions of pixels, so the frame only pays for the copy
+ */
+void UMapGeneration::RebuildRaster()
+{
+	bRasterDirty = false;
+	bRasterHasEdges = bDrawVoronoiEdges;
+
+	const FVector2D BoundsSize = RasterBounds.bIsValid ? RasterBounds.GetSize() : FVector2D::ZeroVector;
+	if (BoundsSize.X <= 0 || BoundsSize.Y <= 0 || RasterTexelsPerUnit <= 0)
+	{
+		RasterTexture = nullptr;
+		return;
+	}
+
+	const FIntPoint Size(FMath::Max(FMath::CeilToInt32(BoundsSize.X * RasterTexelsPerUnit), 1), FMath::Max(FMath::CeilToInt32(BoundsSize.Y * RasterTexelsPerUnit), 1));
+
+	FMapRasterShapes Shapes;
+	TArray<FVector2D, TInlineAllocator<128>> MeshVertices;
+	for (const UMapNode* Node : Nodes)
+	{
+		Node->GetMeshVertices(MeshVertices);
+		const TArray<SlateIndex>& Indices = Node->GetIndices();
+		for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+		{
+			Shapes.AddTriangle(MeshVertices[Indices[Index]], MeshVertices[Indices[Index + 1]], MeshVertices[Indices[Index + 2]], Node->GetColor());
+		}
+	}
+
+	if (bDrawVoronoiEdges)
+	{
+		for (const UNodeEdge* Edge : Edges)
+		{
+			const FLinearColor TypeColor = Edge->GetTypeColor();
+			if (TypeColor.A > 0)
+			{
+				Shapes.AddLine(Edge->GetCurvePoints(), TypeColor.ToFColor(true));
+			}
+		}
+	}
+
+	// The Worker Only Sees its Own Copy, Never the Widget
+	PendingRaster = Async(EAsyncExecution::ThreadPool, [Bounds = RasterBounds, Size, Shapes = MoveTemp(Shapes)]()
+	{
+		FMapRaster Raster;
+		Raster.Reset(Bounds, Size, FColor::Transparent);
+		Raster.DrawShapes(Shapes);
+		return Raster;
+	});
+}
+
+/**
+ * Hands Finished Pixels to RasterTexture
+ * The texture is only recreated when its size changes, otherwise the new pixels are uploaded over it
+ * @param Raster Pixels Drawn by RebuildRaster's Worker
+ */
+void UMapGeneration::UploadRaster(const FMapRaster& Raster)
+{
+	const FIntPoint& Size = Raster.GetSize();
+	if (!RasterTexture || RasterTexture->GetSizeX() != Size.X || RasterTexture->GetSizeY() != Size.Y)
+	{
+		RasterTexture = UTexture2D::CreateTransient(Size.X, Size.Y, PF_B8G8R8A8);
+		if (!RasterTexture)
+		{
+			return;
+		}
+
+		FTexture2DMipMap& Mip = RasterTexture->GetPlatformData()->Mips[0];
+		FMemory::Memcpy(Mip.BulkData.Lock(LOCK_READ_WRITE), Raster.GetPixels().GetData(), Raster.GetPixels().Num() * sizeof(FColor));
+		Mip.BulkData.Unlock();
+		RasterTexture->UpdateResource();
+
+		RasterBrush.SetResourceObject(RasterTexture);
+		RasterBrush.ImageSize = FVector2D(Size);
+		return;
+	}
+
+	// The Render Thread Reads the Pixels Later, so They're Handed Over Along With the Region
+	TArray<FColor>* UploadPixels = new TArray<FColor>(Raster.GetPixels());
+	FUpdateTextureRegion2D* UploadRegion = new FUpdateTextureRegion2D(0, 0, 0, 0, Size.X, Size.Y);
+	RasterTexture->UpdateTextureRegions(0, 1, UploadRegion, Size.X * sizeof(FColor), sizeof(FColor), reinterpret_cast<uint8*>(UploadPixels->GetData()),
+		[UploadPixels](uint8*, const FUpdateTextureRegion2D* Region)
+		{
+			delete UploadPixels;
+			delete Region;
+		});
+}
+
+/**
+ * The Texture is Used While Each of its Texels Covers at Most a Pixel on Screen
+ * @param AllottedGeometry Geometry the Map is Painted in
+ * @return True if the Raster Should Replace the Vector Fill & Edges
+ */
+bool UMapGeneration::ShouldPaintRaster(const FGeometry& AllottedGeometry) const
+{
+	if (!bUseRasterCache || bChunkedWorld || RasterTexelsPerUnit <= 0 || ViewportSize.X <= 0)
+	{
+		return false;
+	}
+
+	return GetPixelsPerUnit(AllottedGeometry) <= RasterTexelsPerUnit;
+}
+
+/**
+ * Picks the Finest Curve Tessellation Whose Segments Still Cover MinCurveSegmentPixels on Screen
+ * @param EdgePixels On-Screen Length of the Edge
+ * @return Curve LOD, the Straight Chord if Even That is Too Fine
+ */
+int32 UMapGeneration::GetCurveLOD(const double EdgePixels) const
+{
+	for (int32 LOD = 0; LOD < UNodeEdge::NumCurveLODs - 1; ++LOD)
+	{
+		if (EdgePixels / (UNodeEdge::GetNumCurvePoints(LOD) - 1) >= MinCurveSegmentPixels)
+		{
+			return LOD;
+		}
+	}
+
+	return UNodeEdge::NumCurveLODs - 1;
+}
+
+/**
+ * Zoom Bands Double the Pixels Per Map Unit Each Step, Tiles are Only Re-Tessellated When the View Changes Band
+ * @param PixelsPerUnit On-Screen Pixels Per Map Unit
+ * @return Band Index, Negative When Zoomed Out Below One Pixel Per Unit
+ */
+int32 UMapGeneration::GetCurveBand(const double PixelsPerUnit)
+{
+	return FMath::FloorToInt32(FMath::Log2(FMath::Max(PixelsPerUnit, UE_DOUBLE_SMALL_NUMBER)));
+}
+
+/**
+ * LOD an Edge is Drawn at in a Band, Depends Only on the Edge so Both Cells & Tiles Sharing it Agree
+ * Edges of ear clipped cells stay at full detail, those cells can't follow a coarser outline, and so do
+ * edges with a single node, whose cell across a chunk seam can't be seen from here
+ * @param Edge Edge Being Tessellated
+ * @param Band Zoom Band the View Draws at
+ * @return Curve LOD of the Edge
+ */
+int32 UMapGeneration::GetEdgeCurveLOD(const UNodeEdge* Edge, const int32 Band) const
+{
+	// The Cell Across a Chunk Seam Holds its Own Copy of the Edge, Full Detail is the One LOD Both Copies Agree on
+	if (!EdgeNodes[Edge->Index].IsShared())
+	{
+		return 0;
+	}
+
+	for (int32 Slot = 0; Slot < 2; ++Slot)
+	{
+		const UMapNode* Node = Edge->GetNode(Slot);
+		if (Node && !Node->SupportsCurveLOD())
+		{
+			return 0;
+		}
 	}
 
-	InvalidNodes.Empty();
+	const double EdgePixels = FVector2D::Distance(Edge->GetPointA(), Edge->GetPointB()) * FMath::Pow(2.0, static_cast<double>(Band));
+	return GetCurveLOD(EdgePixels);
 }
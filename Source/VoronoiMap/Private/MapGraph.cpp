@@ -0,0 +1,379 @@
+/**
+ * @author Devin DeMatto
+ * @file MapGraph.cpp
+ */
+
+#include "MapGraph.h"
+#include "DelaunayHelper.h"
+#include "FPoissonSampling.h"
+#include "NodeEdge.h"
+#include "Algo/Sort.h"
+#include "Async/ParallelFor.h"
+
+namespace
+{
+	// Orders Points by X, then Y
+	bool IsLexicallyLess(const FVector2D& A, const FVector2D& B)
+	{
+		return A.X < B.X || (A.X == B.X && A.Y < B.Y);
+	}
+}
+
+uint32 FMapGraphSettings::GetParameterHash() const
+{
+	uint32 Hash = GetTypeHash(MapSize);
+	Hash = HashCombine(Hash, GetTypeHash(BoundaryOffset));
+	Hash = HashCombine(Hash, GetTypeHash(Iterations));
+	Hash = HashCombine(Hash, GetTypeHash(K));
+	Hash = HashCombine(Hash, GetTypeHash(Spacing));
+
+	// Chunks Must Sample the Same Points Every Time They are Loaded
+	if (bChunked)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(Seed));
+		Hash = HashCombine(Hash, GetTypeHash(ChunkSize));
+	}
+
+	return Hash;
+}
+
+bool FMapGraphSettings::IsPointInsideMap(const FVector2D& Point) const
+{
+	if (bChunked)
+	{
+		return true;
+	}
+
+	// Assuming the map's bottom left corner is at (0,0) and the top right corner is at (MapSize.X, MapSize.Y)
+	const bool bIsInsideX = Point.X >= 0 && Point.X <= MapSize.X;
+	const bool bIsInsideY = Point.Y >= 0 && Point.Y <= MapSize.Y;
+
+	return bIsInsideX && bIsInsideY;
+}
+
+float FMapGenerationTask::GetStageProgress(const EMapGenerationStage Stage)
+{
+	switch (Stage)
+	{
+	case EMapGenerationStage::Points:
+		return 0.0f;
+	case EMapGenerationStage::Triangulation:
+		return 0.2f;
+	case EMapGenerationStage::Graph:
+		return 0.4f;
+	case EMapGenerationStage::Mesh:
+		return 0.7f;
+	case EMapGenerationStage::Terrain:
+		return 0.9f;
+	default:
+		return 1.0f;
+	}
+}
+
+/**
+ * Runs Points -> Delaunay -> Graph, Checking for Cancellation Between Stages
+ * @param Settings Generation Parameters
+ * @param OutGraph Resulting Graph Data
+ * @param Task Optional Progress & Cancellation State
+ * @return False if the Task was Cancelled
+ */
+bool FMapGraphBuilder::Build(const FMapGraphSettings& Settings, FMapGraphData& OutGraph, FMapGenerationTask* Task)
+{
+	if (Task) Task->SetStage(EMapGenerationStage::Points);
+	const TArray<FVector2D> Points = GeneratePoints(Settings);
+
+	if (Task && Task->IsCancelled()) return false;
+	if (Task) Task->SetStage(EMapGenerationStage::Triangulation);
+
+	// Generate Delaunay triangulation
+	const FDelaunayMesh DelaunayMesh = UDelaunayHelper::CreateDelaunayTriangulation(Points);
+
+	if (Task && Task->IsCancelled()) return false;
+	if (Task) Task->SetStage(EMapGenerationStage::Graph);
+
+	// Dual Graph Generation
+	RelateGraph(Settings, DelaunayMesh, Points, OutGraph);
+
+	return !(Task && Task->IsCancelled());
+}
+
+/**
+ * Builds the Cells of One Chunk of an Unbounded World
+ * The chunk is triangulated together with a halo of the 8 surrounding chunks, so its cells come out
+ * identical to the ones its neighbors compute for the same sites
+ * @param Settings Generation Parameters
+ * @param Chunk Chunk Coordinates
+ * @param OutGraph Cells Whose Site Lies Inside the Chunk
+ * @return False if the Chunk Has No Points
+ */
+bool FMapGraphBuilder::BuildChunk(const FMapGraphSettings& Settings, const FIntPoint& Chunk, FMapGraphData& OutGraph)
+{
+	// Chunk's Own Points First, Followed by the Halo
+	TArray<FVector2D> Points = GenerateChunkPoints(Settings, Chunk);
+	const int32 NumOwnedPoints = Points.Num();
+
+	for (int32 Y = -1; Y <= 1; ++Y)
+	{
+		for (int32 X = -1; X <= 1; ++X)
+		{
+			if (X != 0 || Y != 0)
+			{
+				Points.Append(GenerateChunkPoints(Settings, Chunk + FIntPoint(X, Y)));
+			}
+		}
+	}
+
+	if (NumOwnedPoints == 0)
+	{
+		return false;
+	}
+
+	// Chunk Points are Already in World Space
+	FMapGraphSettings ChunkSettings = Settings;
+	ChunkSettings.BoundaryOffset = FVector2D::ZeroVector;
+
+	const FDelaunayMesh DelaunayMesh = UDelaunayHelper::CreateDelaunayTriangulation(Points);
+	RelateGraph(ChunkSettings, DelaunayMesh, Points, OutGraph);
+
+	// Both Chunks Along a Seam Build its Edge, the Lower Chunk's Copy is the One Drawn
+	for (FMapGraphEdge& Edge : OutGraph.Edges)
+	{
+		const bool bIsAOwned = Edge.NodeA != INDEX_NONE && Edge.NodeA < NumOwnedPoints;
+		const bool bIsBOwned = Edge.NodeB != INDEX_NONE && Edge.NodeB < NumOwnedPoints;
+		const int32 HaloSite = bIsAOwned && !bIsBOwned ? Edge.NodeB : (bIsBOwned && !bIsAOwned ? Edge.NodeA : INDEX_NONE);
+		if (HaloSite == INDEX_NONE)
+		{
+			continue;
+		}
+
+		const FVector2D HaloCell = OutGraph.Sites[HaloSite] / Settings.ChunkSize;
+		const FIntPoint HaloChunk(FMath::FloorToInt32(HaloCell.X), FMath::FloorToInt32(HaloCell.Y));
+		Edge.bIsSeamCopy = HaloChunk.Y < Chunk.Y || (HaloChunk.Y == Chunk.Y && HaloChunk.X < Chunk.X);
+	}
+
+	// Halo Cells Belong to the Neighboring Chunks
+	KeepLeadingSites(OutGraph, NumOwnedPoints);
+	return true;
+}
+
+// Creates a Poisson Distribution of Points Based on MapSize
+TArray<FVector2D> FMapGraphBuilder::GeneratePoints(const FMapGraphSettings& Settings)
+{
+	// Setup the random stream
+	FRandomStream RandomStream(Settings.Seed);
+
+	// Call the Poisson Disk Sampling function with Spacing parameter
+	return FPoissonSampling::GeneratePoissonDiscSamples(Settings.MapSize.X + Settings.BoundaryOffset.X, Settings.MapSize.Y + Settings.BoundaryOffset.Y,
+		Settings.Spacing, Settings.K, Settings.Iterations, RandomStream);
+}
+
+/**
+ * Creates a Poisson Distribution of Points Inside a Chunk
+ * Points only depend on the seed & chunk coordinates, and are inset by half the spacing on every side,
+ * so points of adjacent chunks are at least a full spacing apart, the sampler's own exclusion radius
+ * @param Settings Generation Parameters
+ * @param Chunk Chunk Coordinates
+ * @return Points in World Space
+ */
+TArray<FVector2D> FMapGraphBuilder::GenerateChunkPoints(const FMapGraphSettings& Settings, const FIntPoint& Chunk)
+{
+	FRandomStream RandomStream(HashCombine(GetTypeHash(Settings.Seed), GetTypeHash(Chunk)));
+
+	const FVector2D Inset = FVector2D(Settings.Spacing / 2.0f);
+	const FVector2D SampleSize = Settings.ChunkSize - Inset * 2;
+
+	TArray<FVector2D> Points = FPoissonSampling::GeneratePoissonDiscSamples(SampleSize.X, SampleSize.Y, Settings.Spacing, Settings.K, Settings.Iterations, RandomStream);
+
+	const FVector2D Origin = FVector2D(Chunk) * Settings.ChunkSize + Inset;
+	for (FVector2D& Point : Points)
+	{
+		Point += Origin;
+	}
+
+	return Points;
+}
+
+/**
+ * Drops Every Site After the First NumKept, Edges Shared With a Dropped Site Keep INDEX_NONE on That Side
+ * @param Graph Graph to Trim
+ * @param NumKept Number of Leading Sites to Keep
+ */
+void FMapGraphBuilder::KeepLeadingSites(FMapGraphData& Graph, const int32 NumKept)
+{
+	const auto IsKept = [NumKept](const int32 Site) { return Site != INDEX_NONE && Site < NumKept; };
+
+	// Compact edges & their curves, remembering where each kept edge moved to
+	TArray<int32> EdgeRemap;
+	EdgeRemap.Init(INDEX_NONE, Graph.Edges.Num());
+
+	int32 NumEdgesKept = 0;
+	int32 NumCurvePointsKept = 0;
+	for (int32 Index = 0; Index < Graph.Edges.Num(); ++Index)
+	{
+		FMapGraphEdge& Edge = Graph.Edges[Index];
+		if (!IsKept(Edge.NodeA) && !IsKept(Edge.NodeB))
+		{
+			continue;
+		}
+
+		Edge.NodeA = IsKept(Edge.NodeA) ? Edge.NodeA : INDEX_NONE;
+		Edge.NodeB = IsKept(Edge.NodeB) ? Edge.NodeB : INDEX_NONE;
+
+		// Curves are laid out in edge order, so a kept curve only ever moves down
+		FMemory::Memmove(Graph.CurvePoints.GetData() + NumCurvePointsKept, Graph.CurvePoints.GetData() + Edge.CurveStart, Edge.CurveNum * sizeof(FVector2D));
+		Edge.CurveStart = NumCurvePointsKept;
+		NumCurvePointsKept += Edge.CurveNum;
+
+		EdgeRemap[Index] = NumEdgesKept;
+		if (Index != NumEdgesKept)
+		{
+			Graph.Edges[NumEdgesKept] = MoveTemp(Edge);
+		}
+		++NumEdgesKept;
+	}
+	Graph.Edges.SetNum(NumEdgesKept);
+	Graph.CurvePoints.SetNum(NumCurvePointsKept);
+
+	// Kept sites are a prefix, so their own indices don't change
+	Graph.Sites.SetNum(NumKept);
+	Graph.SiteEdges.SetNum(NumKept);
+	Graph.SiteNeighbors.SetNum(NumKept);
+
+	for (int32 Site = 0; Site < NumKept; ++Site)
+	{
+		for (int32& EdgeIndex : Graph.SiteEdges[Site])
+		{
+			EdgeIndex = EdgeRemap[EdgeIndex];
+		}
+
+		Graph.SiteNeighbors[Site].RemoveAll([&IsKept](const int32 Neighbor) { return !IsKept(Neighbor); });
+	}
+}
+
+/**
+ * Relates Graph Data to Structure of Nodes & Edges, All Per-Site and Per-Edge Work is Spread Across Workers
+ * @param Settings Generation Parameters
+ * @param Delaunator Delaunay Graph
+ * @param Points Poisson Random Points
+ * @param OutGraph Resulting Graph Data
+ */
+void FMapGraphBuilder::RelateGraph(const FMapGraphSettings& Settings, const FDelaunayMesh& Delaunator, const TArray<FVector2D>& Points, FMapGraphData& OutGraph)
+{
+	const EParallelForFlags ParallelFlags = GetParallelFlags(Settings.bParallel);
+	const FVector2D HalfOffset = Settings.BoundaryOffset / 2;
+	const int32 NumHalfEdges = Delaunator.HalfEdges.Num();
+
+	// Step 1: Site for each point in the original set.
+	OutGraph.Sites.SetNumUninitialized(Points.Num());
+	ParallelFor(Points.Num(), [&](const int32 Index)
+	{
+		OutGraph.Sites[Index] = Points[Index] - HalfOffset;
+	}, ParallelFlags);
+
+	// Step 2: Circumcenter of every triangle, these are the corners of the Voronoi cells.
+	// Corners are sorted first so the same triangle gives the same circumcenter in any triangulation.
+	TArray<FVector2D>& Circumcenters = OutGraph.Vertices;
+	Circumcenters.SetNumUninitialized(NumHalfEdges / 3);
+	ParallelFor(Circumcenters.Num(), [&](const int32 Index)
+	{
+		const FDelaunayTriangle Triangle = UDelaunayHelper::ConvertTriangleIDToTriangle(Delaunator, FTriangleIndex(Index * 3));
+
+		FVector2D Corners[3] = { Triangle.A, Triangle.B, Triangle.C };
+		Algo::Sort(Corners, IsLexicallyLess);
+
+		const FDelaunayTriangle SortedTriangle(Corners[0], Corners[1], Corners[2], FPointIndex(), FPointIndex(), FPointIndex());
+		Circumcenters[Index] = UDelaunayHelper::GetTriangleCircumcenter(SortedTriangle) - HalfOffset;
+	}, ParallelFlags);
+
+	// Step 3: Every pair of opposite half-edges is one Voronoi edge, the lower half-edge owns it.
+	TArray<int32> HalfEdgeToEdge;
+	HalfEdgeToEdge.Init(INDEX_NONE, NumHalfEdges);
+	TArray<FSideIndex> EdgeOwners;
+	EdgeOwners.Reserve(NumHalfEdges / 2);
+
+	for (FSideIndex SideIndex = 0; SideIndex.Value < static_cast<SIZE_T>(NumHalfEdges); ++SideIndex)
+	{
+		const FSideIndex OppositeEdgeIndex = Delaunator.HalfEdges[SideIndex];
+		if (OppositeEdgeIndex.IsValid() && SideIndex.Value < OppositeEdgeIndex.Value)
+		{
+			HalfEdgeToEdge[SideIndex] = HalfEdgeToEdge[OppositeEdgeIndex] = EdgeOwners.Add(SideIndex);
+		}
+	}
+
+	// Edge Setup & Bezier Calculation Only Touch the Edge Itself & its Slice of the Curve Buffer
+	OutGraph.Edges.SetNum(EdgeOwners.Num());
+	OutGraph.CurvePoints.SetNumUninitialized(EdgeOwners.Num() * UNodeEdge::NumBezierPoints);
+	ParallelFor(OutGraph.Edges.Num(), [&](const int32 Index)
+	{
+		const FSideIndex SideIndex = EdgeOwners[Index];
+		const FSideIndex OppositeEdgeIndex = Delaunator.HalfEdges[SideIndex];
+
+		// Every triangle is one vertex, edges connect the triangles on either side
+		FMapGraphEdge& Edge = OutGraph.Edges[Index];
+		Edge.VertexA = SideIndex / 3;
+		Edge.VertexB = OppositeEdgeIndex / 3;
+
+		// Endpoints in a fixed order, so the curve is evaluated the same way from either side of a chunk border
+		if (IsLexicallyLess(Circumcenters[Edge.VertexB], Circumcenters[Edge.VertexA]))
+		{
+			Swap(Edge.VertexA, Edge.VertexB);
+		}
+
+		const FVector2D& PointA = Circumcenters[Edge.VertexA];
+		const FVector2D& PointB = Circumcenters[Edge.VertexB];
+
+		const bool bIsAInside = Settings.IsPointInsideMap(PointA);
+		const bool bIsBInside = Settings.IsPointInsideMap(PointB);
+		Edge.bIsEdgeInsideMap = bIsAInside && bIsBInside;
+		Edge.bIsPartiallyInMap = bIsAInside != bIsBInside;
+
+		Edge.NodeA = Delaunator.DelaunayTriangles[SideIndex];
+		Edge.NodeB = Delaunator.DelaunayTriangles[UDelaunayHelper::NextHalfEdge(SideIndex)];
+
+		Edge.CurveStart = Index * UNodeEdge::NumBezierPoints;
+		Edge.CurveNum = UNodeEdge::NumBezierPoints;
+		UNodeEdge::EvaluateBezier(PointA, PointB, MakeArrayView(OutGraph.CurvePoints).Slice(Edge.CurveStart, Edge.CurveNum));
+	}, ParallelFlags);
+
+	// Step 4: Circulate around each site, a site only ever writes to its own edge & neighbor lists.
+	OutGraph.SiteEdges.SetNum(Points.Num());
+	OutGraph.SiteNeighbors.SetNum(Points.Num());
+	ParallelFor(Points.Num(), [&](const int32 Index)
+	{
+		const FSideIndex* StartEdge = Delaunator.PointToEdge.Find(FPointIndex(Index));
+		if (!StartEdge)
+		{
+			return; // Duplicate point dropped by triangulation
+		}
+
+		TArray<int32>& SiteEdges = OutGraph.SiteEdges[Index];
+		TArray<int32>& SiteNeighbors = OutGraph.SiteNeighbors[Index];
+
+		FSideIndex Incoming = *StartEdge;
+		do
+		{
+			// Every incoming half-edge starts at a neighboring site
+			SiteNeighbors.Add(Delaunator.DelaunayTriangles[Incoming]);
+
+			if (HalfEdgeToEdge[Incoming] != INDEX_NONE)
+			{
+				SiteEdges.Add(HalfEdgeToEdge[Incoming]);
+			}
+
+			const FSideIndex Outgoing = UDelaunayHelper::NextHalfEdge(Incoming);
+			Incoming = Delaunator.HalfEdges[Outgoing];
+
+			// Reached the hull, the outgoing half-edge ends at the last neighbor
+			if (!Incoming.IsValid())
+			{
+				SiteNeighbors.Add(Delaunator.DelaunayTriangles[UDelaunayHelper::NextHalfEdge(Outgoing)]);
+			}
+		} while (Incoming.IsValid() && Incoming != *StartEdge);
+	}, ParallelFlags);
+}
+
+// Worker Threads are Only Used When Parallel Generation is Enabled
+EParallelForFlags FMapGraphBuilder::GetParallelFlags(const bool bParallel)
+{
+	return bParallel ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread;
+}
@@ -0,0 +1,290 @@
+/**
+ * @author Devin DeMatto
+ * @file MapGraphPyramid.cpp
+ */
+
+#include "MapGraphPyramid.h"
+#include "DelaunayHelper.h"
+#include "Async/ParallelFor.h"
+
+/**
+ * Builds Every Level Above the Full Resolution Map
+ * @param Sites Sites of the Full Resolution Map
+ * @param Spacing Distance Between Full Resolution Sites
+ * @param bParallel Spread Work Across Worker Threads
+ * @param ClipBounds Box Coarse Cells are Clipped to, Like the Map or Chunk the Sites Fill
+ */
+void FMapGraphPyramid::Build(const TArray<FVector2D>& Sites, const float Spacing, const bool bParallel, const FBox2D& ClipBounds)
+{
+	const EParallelForFlags ParallelFlags = FMapGraphBuilder::GetParallelFlags(bParallel);
+	Levels.Reset();
+
+	// Full Resolution Cells are Drawn by the Nodes Themselves, so Level 0 Has no Outlines
+	FMapGraphLevel& Base = Levels.AddDefaulted_GetRef();
+	Base.Graph.Sites = Sites;
+	Base.CellVertexOffsets.Init(0, Sites.Num() + 1);
+	Base.GridCellSize = Spacing;
+
+	float CellSize = Spacing;
+	while (Levels.Num() < MaxLevels && Levels.Last().Num() > MinSites)
+	{
+		CellSize *= Reduction;
+
+		FMapGraphLevel& Fine = Levels.Last();
+		const TArray<int32> KeptSites = SubsampleSites(Fine.Graph.Sites, CellSize);
+		if (KeptSites.Num() < 3)
+		{
+			break;
+		}
+
+		TArray<FVector2D> Points;
+		Points.Reserve(KeptSites.Num());
+		for (const int32 Site : KeptSites)
+		{
+			Points.Add(Fine.Graph.Sites[Site]);
+		}
+
+		// Sites are Already in Map Space
+		FMapGraphSettings Settings;
+		Settings.bParallel = bParallel;
+
+		FMapGraphLevel Coarse;
+		const FDelaunayMesh DelaunayMesh = UDelaunayHelper::CreateDelaunayTriangulation(Points);
+		FMapGraphBuilder::RelateGraph(Settings, DelaunayMesh, Points, Coarse.Graph);
+		BuildSiteGrid(Coarse, CellSize);
+		BuildCellOutlines(Coarse, ClipBounds);
+
+		// Every finer site belongs to the coarse cell containing it
+		Fine.Parents.SetNumUninitialized(Fine.Num());
+		ParallelFor(Fine.Num(), [&](const int32 Index)
+		{
+			Fine.Parents[Index] = FindNearestInGrid(Coarse, Fine.Graph.Sites[Index]);
+		}, ParallelFlags);
+
+		Coarse.Children.SetNum(Coarse.Num());
+		for (int32 Index = 0; Index < Fine.Num(); ++Index)
+		{
+			Coarse.Children[Fine.Parents[Index]].Add(Index);
+		}
+
+		Levels.Add(MoveTemp(Coarse));
+	}
+}
+
+/**
+ * Sets the Full Resolution Colors & Averages Them Up the Pyramid
+ * @param SiteColors Color of Each Full Resolution Site
+ */
+void FMapGraphPyramid::UpdateColors(const TArray<FLinearColor>& SiteColors)
+{
+	if (Levels.IsEmpty())
+	{
+		return;
+	}
+
+	Levels[0].Colors = SiteColors;
+
+	for (int32 LevelIndex = 1; LevelIndex < Levels.Num(); ++LevelIndex)
+	{
+		FMapGraphLevel& Level = Levels[LevelIndex];
+		const TArray<FLinearColor>& ChildColors = Levels[LevelIndex - 1].Colors;
+
+		Level.Colors.SetNumUninitialized(Level.Num());
+		for (int32 Cell = 0; Cell < Level.Num(); ++Cell)
+		{
+			FLinearColor Sum = FLinearColor::Transparent;
+			for (const int32 Child : Level.Children[Cell])
+			{
+				Sum += ChildColors[Child];
+			}
+
+			const int32 NumChildren = Level.Children[Cell].Num();
+			Level.Colors[Cell] = NumChildren > 0 ? Sum / NumChildren : FLinearColor::Transparent;
+		}
+	}
+}
+
+/**
+ * Finest Level Whose Cells are at Least a Given Size
+ * @param MinCellSize Smallest Cell Size Worth Drawing, in Map Space
+ * @return Level Index, the Coarsest Level if None are Large Enough
+ */
+int32 FMapGraphPyramid::GetLevelForCellSize(const float MinCellSize) const
+{
+	for (int32 Level = 0; Level < Levels.Num(); ++Level)
+	{
+		if (Levels[Level].GridCellSize >= MinCellSize)
+		{
+			return Level;
+		}
+	}
+
+	return FMath::Max(Levels.Num() - 1, 0);
+}
+
+/////////////////////
+// Pyramid Helpers //
+/////////////////////
+
+/**
+ * Keeps the First Site Landing in Each Grid Cell, Deterministic for the Same Input
+ * @param Sites Sites to Subsample
+ * @param CellSize Grid Cell Size
+ * @return Indices of the Kept Sites
+ */
+TArray<int32> FMapGraphPyramid::SubsampleSites(const TArray<FVector2D>& Sites, const float CellSize)
+{
+	TArray<int32> KeptSites;
+	TSet<FIntPoint> ClaimedCells;
+
+	for (int32 Site = 0; Site < Sites.Num(); ++Site)
+	{
+		const FIntPoint Cell(FMath::FloorToInt32(Sites[Site].X / CellSize), FMath::FloorToInt32(Sites[Site].Y / CellSize));
+
+		bool bIsAlreadyInSet = false;
+		ClaimedCells.Add(Cell, &bIsAlreadyInSet);
+		if (!bIsAlreadyInSet)
+		{
+			KeptSites.Add(Site);
+		}
+	}
+
+	return KeptSites;
+}
+
+// Subsampled Sites Have a Grid Cell to Themselves
+void FMapGraphPyramid::BuildSiteGrid(FMapGraphLevel& Level, const float CellSize)
+{
+	Level.GridCellSize = CellSize;
+	Level.SiteGrid.Reserve(Level.Num());
+
+	for (int32 Site = 0; Site < Level.Num(); ++Site)
+	{
+		const FVector2D& Position = Level.Graph.Sites[Site];
+		Level.SiteGrid.Add(FIntPoint(FMath::FloorToInt32(Position.X / CellSize), FMath::FloorToInt32(Position.Y / CellSize)), Site);
+	}
+}
+
+/**
+ * Searches Grid Rings Around a Point Until no Closer Site Can Exist,
+ * Falls Back to Checking Every Site When the Rings Run Out Before Proving That
+ * @param Level Level With a Site Grid
+ * @param Point Position on Map
+ * @return Nearest Site
+ */
+int32 FMapGraphPyramid::FindNearestInGrid(const FMapGraphLevel& Level, const FVector2D& Point)
+{
+	constexpr int32 MaxRadius = 16;
+
+	const FIntPoint Center(FMath::FloorToInt32(Point.X / Level.GridCellSize), FMath::FloorToInt32(Point.Y / Level.GridCellSize));
+
+	int32 BestSite = INDEX_NONE;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	bool bIsNearest = false;
+
+	for (int32 Radius = 0; Radius <= MaxRadius && !bIsNearest; ++Radius)
+	{
+		for (int32 Y = -Radius; Y <= Radius; ++Y)
+		{
+			for (int32 X = -Radius; X <= Radius; ++X)
+			{
+				if (FMath::Max(FMath::Abs(X), FMath::Abs(Y)) != Radius)
+				{
+					continue;
+				}
+
+				if (const int32* Site = Level.SiteGrid.Find(Center + FIntPoint(X, Y)))
+				{
+					const double DistanceSquared = FVector2D::DistSquared(Point, Level.Graph.Sites[*Site]);
+					if (DistanceSquared < BestDistanceSquared)
+					{
+						BestDistanceSquared = DistanceSquared;
+						BestSite = *Site;
+					}
+				}
+			}
+		}
+
+		// Sites beyond this ring are at least Radius cells away
+		bIsNearest = BestSite != INDEX_NONE && FMath::Square(Radius * Level.GridCellSize) >= BestDistanceSquared;
+	}
+
+	// Points Far Outside the Map, or Sparse Grids Where the Best Site so Far is Farther Than the Rings Reach
+	if (!bIsNearest)
+	{
+		for (int32 Site = 0; Site < Level.Num(); ++Site)
+		{
+			const double DistanceSquared = FVector2D::DistSquared(Point, Level.Graph.Sites[Site]);
+			if (DistanceSquared < BestDistanceSquared)
+			{
+				BestDistanceSquared = DistanceSquared;
+				BestSite = Site;
+			}
+		}
+	}
+
+	return BestSite;
+}
+
+/**
+ * Clips the Bounds by the Bisector Between Each Site & Each of its Delaunay Neighbors, Which Leaves its Voronoi Cell
+ * Hull cells close along the bounds rather than being dropped, cells entirely past the bounds are left empty
+ * @param Level Level With a Related Graph
+ * @param ClipBounds Box Every Outline is Kept Within
+ */
+void FMapGraphPyramid::BuildCellOutlines(FMapGraphLevel& Level, const FBox2D& ClipBounds)
+{
+	const FMapGraphData& Graph = Level.Graph;
+
+	Level.CellVertices.Reset();
+	Level.CellVertexOffsets.Reset(Level.Num() + 1);
+	Level.CellVertexOffsets.Add(0);
+
+	TArray<FVector2D, TInlineAllocator<16>> Outline;
+	TArray<FVector2D, TInlineAllocator<16>> Clipped;
+	for (int32 Cell = 0; Cell < Level.Num(); ++Cell)
+	{
+		const FVector2D& Site = Graph.Sites[Cell];
+
+		Outline.Reset();
+		Outline.Add(ClipBounds.Min);
+		Outline.Add(FVector2D(ClipBounds.Max.X, ClipBounds.Min.Y));
+		Outline.Add(ClipBounds.Max);
+		Outline.Add(FVector2D(ClipBounds.Min.X, ClipBounds.Max.Y));
+
+		// Keep the Side of Each Bisector Nearer the Site
+		for (int32 Neighbor = 0; Neighbor < Graph.SiteNeighbors[Cell].Num() && Outline.Num() >= 3; ++Neighbor)
+		{
+			const FVector2D& NeighborSite = Graph.Sites[Graph.SiteNeighbors[Cell][Neighbor]];
+			const FVector2D Normal = NeighborSite - Site;
+			const double Offset = Normal | ((Site + NeighborSite) / 2);
+
+			Clipped.Reset();
+			for (int32 Index = 0; Index < Outline.Num(); ++Index)
+			{
+				const FVector2D& Current = Outline[Index];
+				const FVector2D& Next = Outline[(Index + 1) % Outline.Num()];
+				const double CurrentSide = (Normal | Current) - Offset;
+				const double NextSide = (Normal | Next) - Offset;
+
+				if (CurrentSide <= 0)
+				{
+					Clipped.Add(Current);
+				}
+
+				if ((CurrentSide <= 0) != (NextSide <= 0))
+				{
+					Clipped.Add(Current + (Next - Current) * (CurrentSide / (CurrentSide - NextSide)));
+				}
+			}
+			Swap(Outline, Clipped);
+		}
+
+		if (Outline.Num() >= 3)
+		{
+			Level.CellVertices.Append(Outline);
+		}
+
+		Level.CellVertexOffsets.Add(Level.CellVertices.Num());
+	}
+}
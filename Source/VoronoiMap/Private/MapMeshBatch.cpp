@@ -0,0 +1,249 @@
+/**
+ * @author Devin DeMatto
+ * @file MapMeshBatch.cpp
+ */
+
+#include "MapMeshBatch.h"
+#include "Rendering/DrawElements.h"
+
+void FMapMeshBatch::Reset()
+{
+	Positions.Reset();
+	Colors.Reset();
+	Indices.Reset();
+	Invalidate();
+}
+
+void FMapMeshBatch::Reserve(const int32 NumVertices, const int32 NumIndices)
+{
+	Positions.Reserve(NumVertices);
+	Colors.Reserve(NumVertices);
+	Indices.Reserve(NumIndices);
+}
+
+/**
+ * Appends a Triangulated Polygon to the Batch
+ * @param PolygonVertices Vertices in Map Space
+ * @param PolygonIndices Triangles Into PolygonVertices
+ * @param Color Fill Color
+ */
+void FMapMeshBatch::AddPolygon(const TArrayView<const FVector2D> PolygonVertices, const TArrayView<const SlateIndex> PolygonIndices, const FColor& Color)
+{
+	const SlateIndex BaseIndex = Positions.Num();
+	Invalidate();
+
+	for (const FVector2D& Vertex : PolygonVertices)
+	{
+		Positions.Add(FVector2f(Vertex));
+		Colors.Add(Color);
+	}
+
+	for (const SlateIndex Index : PolygonIndices)
+	{
+		Indices.Add(BaseIndex + Index);
+	}
+}
+
+/**
+ * Submits Every Polygon as a Single Custom Verts Element
+ * Vertices are kept between paints, a frame without pan, zoom or data changes reuses them as is
+ * @param OutDrawElements Element List Being Painted
+ * @param LayerId Layer to Draw on
+ * @param MapToRender Map Space to Render Space, One Affine for Every Vertex
+ */
+void FMapMeshBatch::Paint(FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FSlateRenderTransform& MapToRender) const
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	if (!bSlateVerticesValid || SlateVerticesTransform != MapToRender)
+	{
+		// Only Positions Depend on the View, Colors & Texture Coordinates are Written Once Per Rebuild
+		if (!bSlateVerticesValid)
+		{
+			SlateVertices.SetNumUninitialized(Positions.Num(), false);
+			for (int32 Index = 0; Index < Positions.Num(); ++Index)
+			{
+				SlateVertices[Index] = FSlateVertex::Make(MapToRender, Positions[Index], FVector2f::ZeroVector, Colors[Index]);
+			}
+		}
+		else
+		{
+			for (int32 Index = 0; Index < Positions.Num(); ++Index)
+			{
+				SlateVertices[Index].Position = MapToRender.TransformPoint(Positions[Index]);
+			}
+		}
+
+		SlateVerticesTransform = MapToRender;
+		bSlateVerticesValid = true;
+	}
+
+	// The Element Takes its Own Copy of Both Arrays, Frames That Don't Paint at All are the Map View's Invalidation Panel's Job
+	FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, FSlateResourceHandle(), SlateVertices, Indices, nullptr, 0, 0, ESlateDrawEffect::None);
+}
+
+void FMapLineBatch::Reset()
+{
+	Points.Reset();
+	LineStarts.Reset();
+	LineStarts.Add(0);
+	LineColors.Reset();
+	Invalidate();
+}
+
+/**
+ * Appends a Polyline to the Batch
+ * @param LinePoints Points in Map Space
+ * @param Color Line Color
+ */
+void FMapLineBatch::AddLine(const TArrayView<const FVector2D> LinePoints, const FColor& Color)
+{
+	if (LinePoints.Num() < 2)
+	{
+		return;
+	}
+
+	for (const FVector2D& Point : LinePoints)
+	{
+		Points.Add(FVector2f(Point));
+	}
+
+	LineStarts.Add(Points.Num());
+	LineColors.Add(Color);
+	Invalidate();
+}
+
+/**
+ * Expands Every Segment Into a Quad in Render Space & Submits Them as a Single Custom Verts Element
+ * Segments are stretched by half the thickness at both ends, so bends don't leave gaps
+ * @param OutDrawElements Element List Being Painted
+ * @param LayerId Layer to Draw on
+ * @param MapToRender Map Space to Render Space
+ * @param Thickness Line Width in Render Space
+ */
+void FMapLineBatch::Paint(FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FSlateRenderTransform& MapToRender, const float Thickness) const
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	if (!bSlateVerticesValid || SlateVerticesTransform != MapToRender || SlateVerticesThickness != Thickness)
+	{
+		const FSlateRenderTransform Identity;
+		const float HalfThickness = Thickness * 0.5f;
+
+		SlateVertices.Reset(Points.Num() * 4);
+		SlateIndices.Reset(Points.Num() * 6);
+		for (int32 Line = 0; Line < LineColors.Num(); ++Line)
+		{
+			const FColor& Color = LineColors[Line];
+			FVector2f Start = MapToRender.TransformPoint(Points[LineStarts[Line]]);
+			for (int32 Index = LineStarts[Line] + 1; Index < LineStarts[Line + 1]; ++Index)
+			{
+				const FVector2f End = MapToRender.TransformPoint(Points[Index]);
+				const FVector2f Direction = (End - Start).GetSafeNormal();
+				if (Direction.IsZero())
+				{
+					continue;
+				}
+
+				const FVector2f Along = Direction * HalfThickness;
+				const FVector2f Across = FVector2f(-Direction.Y, Direction.X) * HalfThickness;
+
+				const SlateIndex BaseIndex = SlateVertices.Num();
+				SlateVertices.Add(FSlateVertex::Make(Identity, Start - Along + Across, FVector2f::ZeroVector, Color));
+				SlateVertices.Add(FSlateVertex::Make(Identity, Start - Along - Across, FVector2f::ZeroVector, Color));
+				SlateVertices.Add(FSlateVertex::Make(Identity, End + Along + Across, FVector2f::ZeroVector, Color));
+				SlateVertices.Add(FSlateVertex::Make(Identity, End + Along - Across, FVector2f::ZeroVector, Color));
+
+				SlateIndices.Append({ BaseIndex, BaseIndex + 1, BaseIndex + 2, BaseIndex + 2, BaseIndex + 1, BaseIndex + 3 });
+				Start = End;
+			}
+		}
+
+		SlateVerticesTransform = MapToRender;
+		SlateVerticesThickness = Thickness;
+		bSlateVerticesValid = true;
+	}
+
+	if (!SlateIndices.IsEmpty())
+	{
+		FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, FSlateResourceHandle(), SlateVertices, SlateIndices, nullptr, 0, 0, ESlateDrawEffect::None);
+	}
+}
+
+void FMapPointBatch::Reset()
+{
+	Points.Reset();
+	HalfSizes.Reset();
+	Colors.Reset();
+	Invalidate();
+}
+
+void FMapPointBatch::Reserve(const int32 NumPoints)
+{
+	Points.Reserve(NumPoints);
+	HalfSizes.Reserve(NumPoints);
+	Colors.Reserve(NumPoints);
+}
+
+/**
+ * Appends a Marker to the Batch
+ * @param Point Center in Map Space
+ * @param Color Marker Color
+ * @param Size Width & Height in Widget Space, Unaffected by Zoom
+ */
+void FMapPointBatch::AddPoint(const FVector2D& Point, const FColor& Color, const FVector2D& Size)
+{
+	Points.Add(FVector2f(Point));
+	HalfSizes.Add(FVector2f(Size * 0.5));
+	Colors.Add(Color);
+	Invalidate();
+}
+
+/**
+ * Expands Every Marker Into a Quad in Render Space & Submits Them as a Single Custom Verts Element
+ * @param OutDrawElements Element List Being Painted
+ * @param LayerId Layer to Draw on
+ * @param MapToRender Map Space to Render Space
+ * @param Scale Widget Space to Render Space Scale, Applied to Marker Sizes
+ */
+void FMapPointBatch::Paint(FSlateWindowElementList& OutDrawElements, const int32 LayerId, const FSlateRenderTransform& MapToRender, const float Scale) const
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	if (!bSlateVerticesValid || SlateVerticesTransform != MapToRender || SlateVerticesScale != Scale)
+	{
+		const FSlateRenderTransform Identity;
+
+		SlateVertices.Reset(Points.Num() * 4);
+		SlateIndices.Reset(Points.Num() * 6);
+		for (int32 Index = 0; Index < Points.Num(); ++Index)
+		{
+			const FVector2f Center = MapToRender.TransformPoint(Points[Index]);
+			const FVector2f HalfSize = HalfSizes[Index] * Scale;
+			const FColor& Color = Colors[Index];
+
+			const SlateIndex BaseIndex = SlateVertices.Num();
+			SlateVertices.Add(FSlateVertex::Make(Identity, Center + FVector2f(-HalfSize.X, -HalfSize.Y), FVector2f::ZeroVector, Color));
+			SlateVertices.Add(FSlateVertex::Make(Identity, Center + FVector2f(HalfSize.X, -HalfSize.Y), FVector2f::ZeroVector, Color));
+			SlateVertices.Add(FSlateVertex::Make(Identity, Center + FVector2f(-HalfSize.X, HalfSize.Y), FVector2f::ZeroVector, Color));
+			SlateVertices.Add(FSlateVertex::Make(Identity, Center + FVector2f(HalfSize.X, HalfSize.Y), FVector2f::ZeroVector, Color));
+
+			SlateIndices.Append({ BaseIndex, BaseIndex + 1, BaseIndex + 2, BaseIndex + 2, BaseIndex + 1, BaseIndex + 3 });
+		}
+
+		SlateVerticesTransform = MapToRender;
+		SlateVerticesScale = Scale;
+		bSlateVerticesValid = true;
+	}
+
+	FSlateDrawElement::MakeCustomVerts(OutDrawElements, LayerId, FSlateResourceHandle(), SlateVertices, SlateIndices, nullptr, 0, 0, ESlateDrawEffect::None);
+}
@@ -9,14 +9,13 @@
 #include "Biomes.h"
 #include "TerrainGenerator.h"
 #include "CompGeom/PolygonTriangulation.h"
-#include "Algo/Reverse.h"
 
  //////////////////////////////////
  // Logic for Building Structure //
  //////////////////////////////////
 
  /**
- * Setups Node with Critical Information
+ * Setups Node with Critical Information, Resets Any State Left From a Previous Generation
  * @param InMapGenerator Map Generator
  * @param Point Centroid Of Node
  */
@@ -24,23 +23,37 @@ void UMapNode::SetupNode(UMapGeneration* InMapGenerator, const FVector2D Point)
 {
 	Centroid = Point;
 	MapGenerator = InMapGenerator;
+
+	// Pooled Nodes Keep Their Allocations
+	Neighbors.Reset();
+	Edges.Reset();
+	ReversedEdges.Reset();
+	Indices.Reset();
+	NumOutlinePoints = 0;
+	Bounds = FBox2D(ForceInit);
+	bHasFanHub = false;
+
+	BiomeType = EBiomeType::Sea;
+	Height = 0.0f;
+	bMarkedForRemoval = false;
+	Color = FColor::Black;
+	CentroidColor = FLinearColor::Black;
+	bDrawVerticesTraversal = false;
 }
 
 /**
- * Adds Nearby Node as Neighbor
+ * Adds Nearby Node as Neighbor, Only Touches This Node so Sites Can be Related in Parallel
  * @param Neighbor Voronoi Node
  */
 void UMapNode::AddNeighbor(UMapNode* Neighbor) {
 	Neighbors.Add(Neighbor);
-	Neighbor->Neighbors.Add(this);
 }
 
 /**
- * Adds Edge to Node and Adds Node Reference to Edge
+ * Adds Edge to Node, the Edge's Own Node References are Set When the Edge is Created
  * @param Edge Related Edge
  */
 void UMapNode::AddEdge(UNodeEdge* Edge) {
-	Edge->Nodes.Add(this);
 	Edges.Add(Edge);
 }
 
@@ -48,25 +61,28 @@ void UMapNode::AddEdge(UNodeEdge* Edge) {
 // Building Polygon Mesh //
 ///////////////////////////
 
-void UMapNode::BuildMesh()
+/**
+ * Builds Polygon Mesh From Edges, Safe to Run in Parallel Once Every Edge Has its Bezier Points
+ * The outline isn't copied, each edge's curve is referenced in the map's shared buffer with a direction
+ * @return False if the Node is Outside the Map
+ */
+bool UMapNode::BuildMesh()
 {
+	// Nodes Without Edges Can't Form a Polygon
+	if (Edges.IsEmpty())
+	{
+		return false;
+	}
+
 	// Assume Node is Outside Until Proven Otherwise
 	bool bNodeIsOutside = true;
 
-	// Sort Edges Array
-	SortEdges();
-
-	// Add Vertices
-	FVector2D LastPointAdded;
+	// Edges Arrive in Circulation Order so Consecutive Edges Share a Vertex
+	ReversedEdges.Init(false, Edges.Num());
 	for (int32 i = 0; i < Edges.Num(); ++i)
 	{
-		UNodeEdge* CurrentEdge = Edges[i];
-
-		// Check if BezierCurvePoints are empty and calculate if needed
-		if (CurrentEdge->BezierCurvePoints.IsEmpty())
-		{
-			CurrentEdge->CalculateBezier();
-		}
+		const UNodeEdge* CurrentEdge = Edges[i];
+		const UNodeEdge* NextEdge = Edges[(i + 1) % Edges.Num()];
 
 		// Declares Node Inside Map
 		if (bNodeIsOutside && (CurrentEdge->bIsEdgeInsideMap || CurrentEdge->bIsPartiallyInMap))
@@ -74,35 +90,41 @@ void UMapNode::BuildMesh()
 			bNodeIsOutside = false;
 		}
 
-		TArray<FVector2D> PointsToAdd;
-
-		// If it's the first edge or the last point matches the first bezier point, add as is
-		if (i == 0 || LastPointAdded.Equals(CurrentEdge->BezierCurvePoints[0]))
-		{
-			PointsToAdd = CurrentEdge->BezierCurvePoints;
-		}
-		else // If the last point doesn't match, reverse the order
-		{
-			PointsToAdd = CurrentEdge->BezierCurvePoints;
-			Algo::Reverse(PointsToAdd);
-		}
-
-		// Update the last point added for comparison in the next iteration
-		LastPointAdded = PointsToAdd.Last();
-
-		// Add points to Vertices set
-		Vertices.Append(PointsToAdd);
+		// Bezier points run from VertexA to VertexB, walk them as is if VertexB leads into the next edge
+		const bool bIsForward = CurrentEdge->VertexB == NextEdge->VertexA || CurrentEdge->VertexB == NextEdge->VertexB;
+		ReversedEdges[i] = !bIsForward;
+		NumOutlinePoints += CurrentEdge->CurveNum;
 	}
 
-	// If Node is Outside We Remove it
+	// If Node is Outside We Let the Generator Remove it
 	if (bNodeIsOutside)
 	{
-		return MapGenerator->MarkNodeForRemoval(this);
+		return false;
+	}
+
+	ForEachOutlinePoint([this](const FVector2D& Point) { Bounds += Point; });
+
+	// Building Indices, Star-Shaped Cells Fan Out From the Centroid
+	const TArray<SlateIndex>& FanIndices = GetFanIndices();
+	if (NumOutlinePoints >= 3 && (NumOutlinePoints - 1) * 3 <= FanIndices.Num() && IsStarShaped())
+	{
+		bHasFanHub = true;
+		AppendFanIndices(NumOutlinePoints, Indices);
+		return true;
 	}
 
-	// Building Indices
+	// Ear Clipping for the Rare Cell the Curves Bend Past the Centroid
+	TriangulateOutline();
+	return true;
+}
+
+/// Ear Clips the Outline, Only Cells That Aren't Star-Shaped Pay for a Copy of Their Boundary
+void UMapNode::TriangulateOutline()
+{
+	bHasFanHub = false;
+
 	TArray<UE::Geometry::FIndex3i> OutTriangles;
-	PolygonTriangulation::TriangulateSimplePolygon(Vertices, OutTriangles);
+	PolygonTriangulation::TriangulateSimplePolygon(GetOutline(), OutTriangles);
 
 	for (const UE::Geometry::FIndex3i& Triangle : OutTriangles)
 	{
@@ -112,85 +134,190 @@ void UMapNode::BuildMesh()
 	}
 }
 
-void UMapNode::SortEdges()
+/**
+ * Visits the Outline in Circulation Order, Reading Each Edge's Curve Forwards or Backwards
+ * @param Visitor Called Once Per Outline Point
+ * @param EdgeLODs Curve LOD of Each Edge, Neighbors Passing the Same LOD for a Shared Edge Meet Without Gaps
+ */
+void UMapNode::ForEachOutlinePoint(const TFunctionRef<void(const FVector2D&)> Visitor, const TConstArrayView<int32> EdgeLODs) const
 {
-	// Map to store connections
-	TMap<FVector2D, TArray<UNodeEdge*>> EdgeMap;
-	TSet<UNodeEdge*> CheckedEdges; // Set to keep track of checked edges
-
-	// Populate the map and set
-	for (UNodeEdge* Edge : Edges)
+	for (int32 i = 0; i < Edges.Num(); ++i)
 	{
-		EdgeMap.FindOrAdd(Edge->PointA).Add(Edge);
-		EdgeMap.FindOrAdd(Edge->PointB).Add(Edge);
-		CheckedEdges.Add(Edge);
+		const TArrayView<const FVector2D> Curve = Edges[i]->GetCurvePoints();
+		const int32 LOD = EdgeLODs.IsEmpty() ? 0 : EdgeLODs[i];
+		const int32 NumCurvePoints = UNodeEdge::GetNumCurvePoints(LOD);
+
+		if (LOD == 0 && ReversedEdges[i])
+		{
+			for (int32 Point = Curve.Num() - 1; Point >= 0; --Point)
+			{
+				Visitor(Curve[Point]);
+			}
+		}
+		else if (LOD == 0)
+		{
+			for (const FVector2D& Point : Curve)
+			{
+				Visitor(Point);
+			}
+		}
+		else if (ReversedEdges[i])
+		{
+			for (int32 Point = NumCurvePoints - 1; Point >= 0; --Point)
+			{
+				Visitor(Curve[UNodeEdge::GetCurvePointIndex(LOD, Point)]);
+			}
+		}
+		else
+		{
+			for (int32 Point = 0; Point < NumCurvePoints; ++Point)
+			{
+				Visitor(Curve[UNodeEdge::GetCurvePointIndex(LOD, Point)]);
+			}
+		}
 	}
+}
 
-	TArray<UNodeEdge*> SortedEdges;
-	SortedEdges.Reserve(Edges.Num()); // Preallocate memory
+int32 UMapNode::GetNumOutlinePoints(const TConstArrayView<int32> EdgeLODs) const
+{
+	if (EdgeLODs.IsEmpty())
+	{
+		return NumOutlinePoints;
+	}
 
-	UNodeEdge* CurrentEdge = Edges[0];
-	SortedEdges.Add(CurrentEdge);
-	CheckedEdges.Remove(CurrentEdge); // Remove from checked set
+	int32 NumPoints = 0;
+	for (const int32 LOD : EdgeLODs)
+	{
+		NumPoints += UNodeEdge::GetNumCurvePoints(LOD);
+	}
+	return NumPoints;
+}
 
-	FVector2D CurrentEndpoint = CurrentEdge->PointB;
+TArray<FVector2D> UMapNode::GetOutline() const
+{
+	TArray<FVector2D> Outline;
+	Outline.Reserve(NumOutlinePoints);
+	ForEachOutlinePoint([&Outline](const FVector2D& Point) { Outline.Add(Point); });
+	return Outline;
+}
 
-	while (SortedEdges.Num() < Edges.Num())
+/**
+ * Every Outline Edge Winds the Same Way Around the Centroid, so a Fan From it Covers the Cell Without Overlap
+ * Duplicate points where curves meet give zero area triangles, which don't break the fan
+ * @return True if the Outline is Star-Shaped Around the Centroid
+ */
+bool UMapNode::IsStarShaped() const
+{
+	bool bHasPositive = false;
+	bool bHasNegative = false;
+	const auto AddSegment = [&](const FVector2D& A, const FVector2D& B)
+	{
+		const double Cross = FVector2D::CrossProduct(A - Centroid, B - Centroid);
+		bHasPositive |= Cross > UE_KINDA_SMALL_NUMBER;
+		bHasNegative |= Cross < -UE_KINDA_SMALL_NUMBER;
+	};
+
+	// Segments Between Consecutive Points, Then the One Closing the Ring
+	const FVector2D* First = nullptr;
+	const FVector2D* Previous = nullptr;
+	ForEachOutlinePoint([&](const FVector2D& Point)
 	{
-		TArray<UNodeEdge*>* ConnectedEdges = EdgeMap.Find(CurrentEndpoint);
-		if (!ConnectedEdges)
+		if (Previous)
 		{
-			break;
+			AddSegment(*Previous, Point);
 		}
-
-		bool bFoundNextEdge = false;
-
-		for (int32 i = 0; i < ConnectedEdges->Num(); ++i)
+		else
 		{
-			UNodeEdge* Edge = (*ConnectedEdges)[i];
-			if (CheckedEdges.Contains(Edge))
-			{
-				if (Edge->PointA == CurrentEndpoint || Edge->PointB == CurrentEndpoint)
-				{
-					SortedEdges.Add(Edge);
-					CurrentEndpoint = (Edge->PointA == CurrentEndpoint) ? Edge->PointB : Edge->PointA;
-					CheckedEdges.Remove(Edge);
-					bFoundNextEdge = true;
-					break;
-				}
-			}
+			First = &Point;
 		}
+		Previous = &Point;
+	});
+
+	if (First && Previous)
+	{
+		AddSegment(*Previous, *First);
+	}
+
+	return !(bHasPositive && bHasNegative);
+}
+
+/**
+ * Fan Triangles (0, i, i + 1) Around a Hub at Index 0, Built Once & Shared by Every Node
+ * A cell with N outline vertices uses the first N - 1 triangles, so one buffer serves every vertex count
+ */
+const TArray<SlateIndex>& UMapNode::GetFanIndices()
+{
+	static const TArray<SlateIndex> FanIndices = []()
+	{
+		constexpr int32 MaxFanVertices = 1024;
 
-		if (!bFoundNextEdge)
+		TArray<SlateIndex> FanBuffer;
+		FanBuffer.Reserve(MaxFanVertices * 3);
+		for (int32 i = 1; i < MaxFanVertices; ++i)
 		{
-			break;
+			FanBuffer.Add(0);
+			FanBuffer.Add(i);
+			FanBuffer.Add(i + 1);
 		}
-	}
+		return FanBuffer;
+	}();
+
+	return FanIndices;
+}
+
+/**
+ * Triangles (Hub, i, i + 1) Up to the Last Vertex, Then Close the Ring Back to the First
+ * @param NumOutline Outline Points Following the Hub, at Most as Many as GetFanIndices Covers
+ * @param OutIndices Indices to Append to
+ */
+void UMapNode::AppendFanIndices(const int32 NumOutline, TArray<SlateIndex>& OutIndices)
+{
+	const TArray<SlateIndex>& FanIndices = GetFanIndices();
+	check((NumOutline - 1) * 3 <= FanIndices.Num());
 
-	Edges = MoveTemp(SortedEdges);
+	OutIndices.Append(FanIndices.GetData(), (NumOutline - 1) * 3);
+	OutIndices.Add(0);
+	OutIndices.Add(NumOutline);
+	OutIndices.Add(1);
 }
 
 ////////////////////////////
 // Node Positioning Check //
 ////////////////////////////
 
-bool UMapNode::IsInNode(const FVector2D& Point)
+bool UMapNode::IsInNode(const FVector2D& Point) const
 {
-	const int32 NumVertices = Vertices.Num();
-	if (NumVertices < 3)
+	if (NumOutlinePoints < 3)
 	{
 		return false;
 	}
 
 	bool bIsInside = false;
-	for (int32 i = 0, j = NumVertices - 1; i < NumVertices; j = i++)
+	const auto CrossSegment = [&Point, &bIsInside](const FVector2D& A, const FVector2D& B)
 	{
-		if (((Vertices[i].Y > Point.Y) != (Vertices[j].Y > Point.Y)) &&
-			(Point.X < (Vertices[j].X - Vertices[i].X) * (Point.Y - Vertices[i].Y) / (Vertices[j].Y - Vertices[i].Y) + Vertices[i].X))
+		if (((A.Y > Point.Y) != (B.Y > Point.Y)) &&
+			(Point.X < (B.X - A.X) * (Point.Y - A.Y) / (B.Y - A.Y) + A.X))
 		{
 			bIsInside = !bIsInside;
 		}
-	}
+	};
+
+	// Curve points live in the map's buffer, so pointers stay valid across the walk
+	const FVector2D* First = nullptr;
+	const FVector2D* Previous = nullptr;
+	ForEachOutlinePoint([&](const FVector2D& Vertex)
+	{
+		if (Previous)
+		{
+			CrossSegment(Vertex, *Previous);
+		}
+		else
+		{
+			First = &Vertex;
+		}
+		Previous = &Vertex;
+	});
+	CrossSegment(*First, *Previous);
 
 	return bIsInside;
 }
@@ -257,6 +384,8 @@ void UMapNode::UpdateNode()
 	{
 		Color = FColor(TempColor.R * ShadeFactor, TempColor.G * ShadeFactor, TempColor.B * ShadeFactor, TempColor.A);
 	}
+
+	MapGenerator->MarkCellBatchDirty();
 }
 
 /////////////
@@ -284,115 +413,49 @@ void UMapNode::SetHeight(const float Value, const bool bIsUpdate)
 
 FVector2D UMapNode::GetCentroid() const { return Centroid; }
 
+void UMapNode::SetDrawVerticesTraversal(const bool bInDrawVerticesTraversal)
+{
+	if (bDrawVerticesTraversal != bInDrawVerticesTraversal)
+	{
+		bDrawVerticesTraversal = bInDrawVerticesTraversal;
+
+		if (MapGenerator)
+		{
+			MapGenerator->InvalidateMap();
+		}
+	}
+}
+
 //////////////////
 //  Event Logic //
 //////////////////
 
-int32 UMapNode::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+void UMapNode::PaintOverlay(const FPaintContext& OverlayContext) const
 {
 	if (MapGenerator)
 	{
-		auto Context = FPaintContext(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
-		MapGenerator->DrawPolygon(Context, AllottedGeometry, Vertices, Indices, Color);
-
 		if (MapGenerator->GetSelectedNode() == this && bDrawVerticesTraversal)
 		{
 			constexpr FLinearColor StartColor = FLinearColor(0.0f, 1.0f, 1.0f, 1.0f); // Cyan (mixture of green and blue)
 			constexpr FLinearColor EndColor = FLinearColor(1.0f, 0.0f, 0.0f, 1.0f); // Bright red
 
-			const int VertexCount = Vertices.Num();
+			const TArray<FVector2D> Outline = GetOutline();
+			const int VertexCount = Outline.Num();
 			for (int i = 0; i < VertexCount; ++i)
 			{
 				const float LeperFactor = static_cast<float>(i) / (VertexCount - 1);
 				FLinearColor CalculatedColor = FLinearColor::LerpUsingHSV(StartColor, EndColor, LeperFactor);
 
-				Context.LayerId += 1;
-				MapGenerator->DrawPoint(Context, AllottedGeometry, Vertices[i], CalculatedColor, FVector2D(1, 1) * 10);
-			}
-		}
-
-		if (MapGenerator->bDrawVoronoiEdges)
-		{
-			LayerId += 1;
-			for (const UNodeEdge* Edge : Edges)
-			{
-				if (Edge->Nodes[0] == this)
-				{
-					Edge->NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
-				}
+				MapGenerator->DrawPoint(Outline[i], CalculatedColor, FVector2D(1, 1) * 10);
 			}
 		}
 
-		if (MapGenerator->bDrawVoronoiCentroids)
-		{
-			Context.LayerId += 1;
-			MapGenerator->DrawPoint(Context, AllottedGeometry, Centroid, CentroidColor, FVector2D(2.0f, 2.0f));
-		}
-
 		if (MapGenerator->bDrawDelaunayTriangles && MapGenerator->GetSelectedNode() == this)
 		{
 			for (const UMapNode* Neighbor : Neighbors)
 			{
-				Context.LayerId += 1;
-				MapGenerator->DrawLine(Context, AllottedGeometry, Centroid, Neighbor->Centroid, FLinearColor::Red, 1.0);
+				MapGenerator->DrawLine(OverlayContext, OverlayContext.AllottedGeometry, Centroid, Neighbor->Centroid, FLinearColor::Red, 1.0);
 			}
 		}
 	}
-
-	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
-}
-
-FReply UMapNode::NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
-{
-	if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton && IsInNode(MapGenerator->GetMousePositionInVirtualSpace()))
-	{
-		MapGenerator->SetSelectedNode(this);
-	}
-
-	if (InMouseEvent.GetEffectingButton() == EKeys::LeftMouseButton && MapGenerator->GetSelectedNode() == this)
-	{
-		// Log Centroid
-		//UE_LOG(LogTemp, Warning, TEXT("Node Centroid: (%f, %f)"), Centroid.X, Centroid.Y);
-
-		// Log Neighbors
-		//for (const UMapNode* Neighbor : Neighbors)
-		//{
-		//	const FVector2D NeighborCentroid = Neighbor->Centroid;
-		//	UE_LOG(LogTemp, Warning, TEXT("Neighbor Centroid: (%f, %f)"), NeighborCentroid.X, NeighborCentroid.Y);
-		//}
-
-		// Log Edges
-		// UE_LOG(LogTemp, Warning, TEXT("Edges Total: %d"), Edges.Num());
-		//for (const UNodeEdge* Edge : Edges)
-		//{
-		// UE_LOG(LogTemp, Warning, TEXT("Edge Points: A(%f, %f), B(%f, %f)"), Edge->PointA.X, Edge->PointA.Y, Edge->PointB.X, Edge->PointB.Y);
-		//}
-
-		// Log Vertices for Mesh Generation
-		//for (const FVector2D& Vertex : Vertices)
-		//{
-		//	UE_LOG(LogTemp, Warning, TEXT("Mesh Vertex: (%f, %f)"), Vertex.X, Vertex.Y);
-		//}
-
-		// Log Indices for Mesh Generation
-		//for (const SlateIndex& Index : Indices)
-		//{
-		//	UE_LOG(LogTemp, Warning, TEXT("Mesh Index: %d"), Index);
-		//}
-	}
-
-	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
-}
-
-FReply UMapNode::NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
-{
-
-
-	return Super::NativeOnMouseMove(InGeometry, InMouseEvent);
-}
-
-FReply UMapNode::NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent)
-{
-
-	return Super::NativeOnMouseButtonDown(InGeometry, InMouseEvent);
 }
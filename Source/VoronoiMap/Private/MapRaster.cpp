@@ -0,0 +1,168 @@
+/**
+ * @author Devin DeMatto
+ * @file MapRaster.cpp
+ */
+
+#include "MapRaster.h"
+
+/**
+ * Queues a Filled Triangle
+ * @param A First Corner in Map Space
+ * @param B Second Corner in Map Space
+ * @param C Third Corner in Map Space
+ * @param Color Fill Color
+ */
+void FMapRasterShapes::AddTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FColor& Color)
+{
+	TriangleCorners.Add(A);
+	TriangleCorners.Add(B);
+	TriangleCorners.Add(C);
+	TriangleColors.Add(Color);
+}
+
+/**
+ * Queues a Polyline
+ * @param Points Polyline in Map Space
+ * @param Color Line Color
+ */
+void FMapRasterShapes::AddLine(const TArrayView<const FVector2D> Points, const FColor& Color)
+{
+	LinePoints.Append(Points.GetData(), Points.Num());
+	LineEnds.Add(LinePoints.Num());
+	LineColors.Add(Color);
+}
+
+/**
+ * Sizes the Buffer & Clears it
+ * @param InBounds Map Space Box to Cover
+ * @param InSize Pixels Along Each Axis
+ * @param ClearColor Color of Pixels no Shape Covers
+ */
+void FMapRaster::Reset(const FBox2D& InBounds, const FIntPoint& InSize, const FColor& ClearColor)
+{
+	Bounds = InBounds;
+	Size = FIntPoint(FMath::Max(InSize.X, 0), FMath::Max(InSize.Y, 0));
+	Pixels.Init(ClearColor, Size.X * Size.Y);
+	LineStamps.Init(0, Size.X * Size.Y);
+	LineStamp = 0;
+
+	const FVector2D BoundsSize = Bounds.bIsValid ? Bounds.GetSize() : FVector2D::ZeroVector;
+	Scale = FVector2D(BoundsSize.X > 0 ? Size.X / BoundsSize.X : 0, BoundsSize.Y > 0 ? Size.Y / BoundsSize.Y : 0);
+}
+
+/**
+ * Sets Every Pixel Whose Center Lies in the Triangle, Either Winding is Accepted
+ * @param A First Corner in Map Space
+ * @param B Second Corner in Map Space
+ * @param C Third Corner in Map Space
+ * @param Color Fill Color
+ */
+void FMapRaster::FillTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FColor& Color)
+{
+	const FVector2D P0 = ToPixelSpace(A);
+	const FVector2D P1 = ToPixelSpace(B);
+	const FVector2D P2 = ToPixelSpace(C);
+
+	const double Area = FVector2D::CrossProduct(P1 - P0, P2 - P0);
+	if (FMath::IsNearlyZero(Area))
+	{
+		return;
+	}
+
+	const int32 MinX = FMath::Max(FMath::FloorToInt32(FMath::Min3(P0.X, P1.X, P2.X)), 0);
+	const int32 MinY = FMath::Max(FMath::FloorToInt32(FMath::Min3(P0.Y, P1.Y, P2.Y)), 0);
+	const int32 MaxX = FMath::Min(FMath::CeilToInt32(FMath::Max3(P0.X, P1.X, P2.X)), Size.X - 1);
+	const int32 MaxY = FMath::Min(FMath::CeilToInt32(FMath::Max3(P0.Y, P1.Y, P2.Y)), Size.Y - 1);
+
+	// Flip the edge functions for clockwise triangles so inside is always positive
+	const double Sign = Area > 0 ? 1.0 : -1.0;
+	for (int32 Y = MinY; Y <= MaxY; ++Y)
+	{
+		for (int32 X = MinX; X <= MaxX; ++X)
+		{
+			const FVector2D Center(X + 0.5, Y + 0.5);
+			if (Sign * FVector2D::CrossProduct(P1 - P0, Center - P0) >= 0 &&
+				Sign * FVector2D::CrossProduct(P2 - P1, Center - P1) >= 0 &&
+				Sign * FVector2D::CrossProduct(P0 - P2, Center - P2) >= 0)
+			{
+				Pixels[Y * Size.X + X] = Color;
+			}
+		}
+	}
+}
+
+/**
+ * Steps Along Each Segment a Pixel at a Time, Blending by the Color's Alpha
+ * Each pixel is blended once per line, steps & shared segment ends would otherwise darken it
+ * @param Points Polyline in Map Space
+ * @param Color Line Color
+ */
+void FMapRaster::DrawLine(const TArrayView<const FVector2D> Points, const FColor& Color)
+{
+	// Stamps From an Earlier Line Could Match Again Once the Counter Wraps
+	if (++LineStamp == 0)
+	{
+		LineStamps.Init(0, Pixels.Num());
+		LineStamp = 1;
+	}
+
+	for (int32 Index = 1; Index < Points.Num(); ++Index)
+	{
+		const FVector2D Start = ToPixelSpace(Points[Index - 1]);
+		const FVector2D End = ToPixelSpace(Points[Index]);
+
+		const int32 Steps = FMath::Max(FMath::CeilToInt32(FMath::Max(FMath::Abs(End.X - Start.X), FMath::Abs(End.Y - Start.Y))), 1);
+		for (int32 Step = 0; Step <= Steps; ++Step)
+		{
+			const FVector2D Point = FMath::Lerp(Start, End, static_cast<double>(Step) / Steps);
+			const int32 X = FMath::FloorToInt32(Point.X);
+			const int32 Y = FMath::FloorToInt32(Point.Y);
+			if (X < 0 || Y < 0 || X >= Size.X || Y >= Size.Y)
+			{
+				continue;
+			}
+
+			uint32& Stamp = LineStamps[Y * Size.X + X];
+			if (Stamp != LineStamp)
+			{
+				Stamp = LineStamp;
+				BlendPixel(X, Y, Color);
+			}
+		}
+	}
+}
+
+/**
+ * Fills Every Triangle, Then Draws Every Line Over Them, Both in the Order They Were Added
+ * @param Shapes Shapes in Map Space
+ */
+void FMapRaster::DrawShapes(const FMapRasterShapes& Shapes)
+{
+	for (int32 Triangle = 0; Triangle < Shapes.TriangleColors.Num(); ++Triangle)
+	{
+		const int32 Corner = Triangle * 3;
+		FillTriangle(Shapes.TriangleCorners[Corner], Shapes.TriangleCorners[Corner + 1], Shapes.TriangleCorners[Corner + 2], Shapes.TriangleColors[Triangle]);
+	}
+
+	int32 LineStart = 0;
+	for (int32 Line = 0; Line < Shapes.LineColors.Num(); ++Line)
+	{
+		DrawLine(TArrayView<const FVector2D>(Shapes.LinePoints).Slice(LineStart, Shapes.LineEnds[Line] - LineStart), Shapes.LineColors[Line]);
+		LineStart = Shapes.LineEnds[Line];
+	}
+}
+
+void FMapRaster::BlendPixel(const int32 X, const int32 Y, const FColor& Color)
+{
+	if (X < 0 || Y < 0 || X >= Size.X || Y >= Size.Y)
+	{
+		return;
+	}
+
+	FColor& Pixel = Pixels[Y * Size.X + X];
+	const int32 Alpha = Color.A;
+	Pixel.R = static_cast<uint8>((Color.R * Alpha + Pixel.R * (255 - Alpha)) / 255);
+	Pixel.G = static_cast<uint8>((Color.G * Alpha + Pixel.G * (255 - Alpha)) / 255);
+	Pixel.B = static_cast<uint8>((Color.B * Alpha + Pixel.B * (255 - Alpha)) / 255);
+	Pixel.A = FMath::Max(Pixel.A, Color.A);
+}
@@ -0,0 +1,190 @@
+/**
+ * @author Devin DeMatto
+ * @file MapSiteIndex.cpp
+ */
+
+#include "MapSiteIndex.h"
+
+/**
+ * Buckets Every Site Into a Grid Covering Their Bounds, Counting Sort Keeps it Two Linear Passes
+ * @param InSites Site of Each Node, in Map Space
+ * @param InCellSize Side Length of a Grid Cell
+ */
+void FMapSiteIndex::Build(const TArray<FVector2D>& InSites, const float InCellSize)
+{
+	Reset();
+	if (InSites.IsEmpty() || InCellSize <= 0)
+	{
+		return;
+	}
+
+	Sites = InSites;
+	CellSize = InCellSize;
+
+	const FBox2D Bounds(Sites);
+	Origin = Bounds.Min;
+	Dimensions = FIntPoint(FMath::FloorToInt32(Bounds.GetSize().X / CellSize) + 1, FMath::FloorToInt32(Bounds.GetSize().Y / CellSize) + 1);
+
+	// Count sites per cell, then turn the counts into offsets
+	TArray<int32> SiteCells;
+	SiteCells.SetNumUninitialized(Sites.Num());
+	CellStarts.Init(0, Dimensions.X * Dimensions.Y + 1);
+	for (int32 Site = 0; Site < Sites.Num(); ++Site)
+	{
+		const FIntPoint Cell = GetCell(Sites[Site]);
+		SiteCells[Site] = Cell.Y * Dimensions.X + Cell.X;
+		++CellStarts[SiteCells[Site] + 1];
+	}
+
+	for (int32 Cell = 1; Cell < CellStarts.Num(); ++Cell)
+	{
+		CellStarts[Cell] += CellStarts[Cell - 1];
+	}
+
+	TArray<int32> Cursor(CellStarts.GetData(), CellStarts.Num() - 1);
+	CellSites.SetNumUninitialized(Sites.Num());
+	for (int32 Site = 0; Site < Sites.Num(); ++Site)
+	{
+		CellSites[Cursor[SiteCells[Site]]++] = Site;
+	}
+}
+
+void FMapSiteIndex::Reset()
+{
+	Sites.Reset();
+	CellStarts.Reset();
+	CellSites.Reset();
+	Dimensions = FIntPoint::ZeroValue;
+}
+
+/**
+ * Finds the Site Whose Voronoi Cell Contains a Point
+ * @param Point Point in Map Space, Points Outside the Grid Start From the Nearest Border Cell
+ * @return Index of the Nearest Site, INDEX_NONE if the Index is Empty
+ */
+int32 FMapSiteIndex::FindNearest(const FVector2D& Point) const
+{
+	int32 BestSite = INDEX_NONE;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+
+	SearchRings(Point, [&](const int32 Site, const double DistanceSquared)
+	{
+		if (DistanceSquared < BestDistanceSquared)
+		{
+			BestDistanceSquared = DistanceSquared;
+			BestSite = Site;
+		}
+	}, [&]() { return BestDistanceSquared; });
+
+	return BestSite;
+}
+
+/**
+ * Finds the Sites Closest to a Point, Nearest First
+ * @param Point Point in Map Space
+ * @param Count Number of Sites Wanted, Fewer are Returned if the Index Holds Fewer
+ * @param OutSites Site Indices Sorted by Distance
+ */
+void FMapSiteIndex::FindKNearest(const FVector2D& Point, const int32 Count, TArray<int32>& OutSites) const
+{
+	OutSites.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	// Best candidates so far, kept sorted so the farthest one bounds the search
+	TArray<TPair<double, int32>, TInlineAllocator<16>> Best;
+	SearchRings(Point, [&](const int32 Site, const double DistanceSquared)
+	{
+		if (Best.Num() == Count && DistanceSquared >= Best.Last().Key)
+		{
+			return;
+		}
+
+		if (Best.Num() == Count)
+		{
+			Best.Pop(false);
+		}
+
+		int32 Slot = Best.Num();
+		while (Slot > 0 && Best[Slot - 1].Key > DistanceSquared)
+		{
+			--Slot;
+		}
+		Best.Insert(TPair<double, int32>(DistanceSquared, Site), Slot);
+	}, [&]() { return Best.Num() == Count ? Best.Last().Key : TNumericLimits<double>::Max(); });
+
+	OutSites.Reserve(Best.Num());
+	for (const TPair<double, int32>& Candidate : Best)
+	{
+		OutSites.Add(Candidate.Value);
+	}
+}
+
+/**
+ * Visits Rings of Cells Outwards From the Point's Cell Until no Unvisited Site Can Beat the Caller's Bound
+ * @param Point Point in Map Space
+ * @param VisitSite Called With Each Site & its Squared Distance to the Point
+ * @param GetBoundSquared Squared Distance the Caller Still Needs Sites Within
+ */
+template <typename VisitorType, typename BoundType>
+void FMapSiteIndex::SearchRings(const FVector2D& Point, VisitorType&& VisitSite, BoundType&& GetBoundSquared) const
+{
+	if (IsEmpty())
+	{
+		return;
+	}
+
+	// Points outside the grid search from the nearest point on it, every site is at least as close to that point
+	const FVector2D GridMax = Origin + FVector2D(Dimensions) * CellSize;
+	const FVector2D Clamped(FMath::Clamp(Point.X, Origin.X, GridMax.X), FMath::Clamp(Point.Y, Origin.Y, GridMax.Y));
+
+	const FIntPoint Center = GetCell(Clamped);
+	const int32 MaxRadius = FMath::Max(Dimensions.X, Dimensions.Y);
+
+	for (int32 Radius = 0; Radius <= MaxRadius; ++Radius)
+	{
+		for (int32 Y = Center.Y - Radius; Y <= Center.Y + Radius; ++Y)
+		{
+			if (Y < 0 || Y >= Dimensions.Y)
+			{
+				continue;
+			}
+
+			// Inner rows of the ring only have their two end cells
+			const bool bIsEdgeRow = FMath::Abs(Y - Center.Y) == Radius;
+			const int32 Step = bIsEdgeRow || Radius == 0 ? 1 : Radius * 2;
+			for (int32 X = Center.X - Radius; X <= Center.X + Radius; X += Step)
+			{
+				if (X < 0 || X >= Dimensions.X)
+				{
+					continue;
+				}
+
+				const int32 Cell = Y * Dimensions.X + X;
+				for (int32 Slot = CellStarts[Cell]; Slot < CellStarts[Cell + 1]; ++Slot)
+				{
+					const int32 Site = CellSites[Slot];
+					VisitSite(Site, FVector2D::DistSquared(Point, Sites[Site]));
+				}
+			}
+		}
+
+		// Cells beyond this ring are at least as far as the ring's border from the clamped point, and so from the point
+		const FVector2D RingMin = Origin + FVector2D(Center - FIntPoint(Radius, Radius)) * CellSize;
+		const FVector2D RingMax = Origin + FVector2D(Center + FIntPoint(Radius + 1, Radius + 1)) * CellSize;
+		const double BorderDistance = FMath::Min(FMath::Min(Clamped.X - RingMin.X, RingMax.X - Clamped.X), FMath::Min(Clamped.Y - RingMin.Y, RingMax.Y - Clamped.Y));
+		if (BorderDistance > 0 && FMath::Square(BorderDistance) >= GetBoundSquared())
+		{
+			break;
+		}
+	}
+}
+
+// Grid Cell Containing a Point, Clamped to the Grid
+FIntPoint FMapSiteIndex::GetCell(const FVector2D& Point) const
+{
+	const FVector2D Local = (Point - Origin) / CellSize;
+	return FIntPoint(FMath::Clamp(FMath::FloorToInt32(Local.X), 0, Dimensions.X - 1), FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, Dimensions.Y - 1));
+}
@@ -5,50 +5,89 @@
 
 #include "NodeEdge.h"
 #include "MapGeneration.h"
+#include "MapGraph.h"
 
  /**
-  * Initializes the Edge
-  * @param InPointA Position on Map
-  * @param InPointB Position on Map
+  * Initializes the Edge, Resets Any State Left From a Previous Generation
+  * Bounds are decided by the graph builder, so edges never read widget state
+ * Runs on workers, so only the edge itself is written, the caller flags the map's batches once all edges are set up
+  * @param GraphEdge Edge Data From the Graph Builder, Bezier Points are Copied Into the Map's Curve Buffer Separately
+  * @param VertexOffset Where the Graph's Vertices Start in the Map's Vertex Pool
   * @param InMapGenerator Map Reference
   */
-void UNodeEdge::SetupEdge(const FVector2D& InPointA, const FVector2D& InPointB, UMapGeneration* InMapGenerator) {
+void UNodeEdge::SetupEdge(const FMapGraphEdge& GraphEdge, const int32 VertexOffset, UMapGeneration* InMapGenerator) {
 	MapGenerator = InMapGenerator;
-	PointA = InPointA;
-	PointB = InPointB;
-	bIsEdgeInsideMap = IsPointInsideMap(PointA) && IsPointInsideMap(PointB);
-	bIsPartiallyInMap = !IsPointInsideMap(PointA) && IsPointInsideMap(PointB) || IsPointInsideMap(PointA) && !IsPointInsideMap(PointB);
+	EdgeType = EEdgeType::None;
+	SelectionState = ESelectionState::Default;
+
+	// Set Directly, UpdateEdgeColor Would Flag the Map's Batch From Every Worker at Once
+	Color = GetTypeColor();
+
+	VertexA = VertexOffset + GraphEdge.VertexA;
+	VertexB = VertexOffset + GraphEdge.VertexB;
+	bIsEdgeInsideMap = GraphEdge.bIsEdgeInsideMap;
+	bIsPartiallyInMap = GraphEdge.bIsPartiallyInMap;
+	bIsSeamCopy = GraphEdge.bIsSeamCopy;
+}
+
+UMapNode* UNodeEdge::GetNode(const int32 Slot) const {
+	return MapGenerator->GetEdgeNode(Index, Slot);
+}
+
+const FVector2D& UNodeEdge::GetPointA() const {
+	return MapGenerator->GetVertices()[VertexA];
+}
+
+const FVector2D& UNodeEdge::GetPointB() const {
+	return MapGenerator->GetVertices()[VertexB];
+}
+
+TArrayView<const FVector2D> UNodeEdge::GetCurvePoints() const {
+	return MakeArrayView(MapGenerator->GetCurvePoints()).Slice(CurveStart, CurveNum);
+}
+
+// Spacing Between Kept Points of the Full Curve at an LOD
+static int32 GetCurveStride(const int32 LOD)
+{
+	return LOD >= UNodeEdge::NumCurveLODs - 1 ? UNodeEdge::NumBezierPoints - 1 : 1 << LOD;
+}
+
+int32 UNodeEdge::GetNumCurvePoints(const int32 LOD)
+{
+	return (NumBezierPoints - 2) / GetCurveStride(LOD) + 2;
+}
+
+int32 UNodeEdge::GetCurvePointIndex(const int32 LOD, const int32 Index)
+{
+	return FMath::Min(Index * GetCurveStride(LOD), NumBezierPoints - 1);
 }
 
-void UNodeEdge::CalculateBezier() {
+/**
+ * Evaluates the Curved Edge Between Two Points, Touches No UObject State so Workers Can Call it
+ * @param InPointA Start of Curve
+ * @param InPointB End of Curve
+ * @param OutPoints Slice of a Curve Buffer to Fill, One Point is Evaluated Per Element
+ */
+void UNodeEdge::EvaluateBezier(const FVector2D& InPointA, const FVector2D& InPointB, TArrayView<FVector2D> OutPoints) {
 	// Calculate the midpoint of the line segment
-	const FVector2D MidPoint = (PointA + PointB) / 2.0f;
+	const FVector2D MidPoint = (InPointA + InPointB) / 2.0f;
 
 	// Calculate a vector perpendicular to the line segment
-	const FVector2D Perpendicular = FVector2D(PointB.Y - PointA.Y, PointA.X - PointB.X).GetSafeNormal();
+	const FVector2D Perpendicular = FVector2D(InPointB.Y - InPointA.Y, InPointA.X - InPointB.X).GetSafeNormal();
 
 	// Set a distance for how far the control points should be from the midpoint
-	const float ControlPointDistance = (PointA - PointB).Size() / 3.0f; // Adjust this factor as needed
+	const float ControlPointDistance = (InPointA - InPointB).Size() / 3.0f; // Adjust this factor as needed
 
 	// Define the control points dynamically
 	const FVector2D ControlPoint1 = MidPoint + Perpendicular * ControlPointDistance;
 	const FVector2D ControlPoint2 = MidPoint - Perpendicular * ControlPointDistance;
 
-	// Define the control points array including PointA, PointB, and the dynamically calculated control points
-	FVector ControlPoints[4];
-	ControlPoints[0] = FVector(PointA.X, PointA.Y, 0); // Convert PointA to FVector
-	ControlPoints[1] = FVector(ControlPoint1.X, ControlPoint1.Y, 0); // First dynamic control point
-	ControlPoints[2] = FVector(ControlPoint2.X, ControlPoint2.Y, 0); // Second dynamic control point
-	ControlPoints[3] = FVector(PointB.X, PointB.Y, 0); // Convert PointB to FVector
-
-	// Evaluate the Bezier Curve
-	TArray<FVector> OutPoints;
-	FVector::EvaluateBezier(ControlPoints, 12, OutPoints);
-
-	// Clear previous points and populate BezierCurvePoints
-	BezierCurvePoints.Empty();
-	for (const FVector& Point : OutPoints) {
-		BezierCurvePoints.Add(FVector2D(Point.X, Point.Y));
+	// Evaluate the cubic Bezier straight into the output, the first and last points land exactly on PointA & PointB
+	const int32 NumPoints = OutPoints.Num();
+	for (int32 Index = 0; Index < NumPoints; ++Index) {
+		const double T = NumPoints > 1 ? static_cast<double>(Index) / (NumPoints - 1) : 0.0;
+		const double U = 1.0 - T;
+		OutPoints[Index] = InPointA * (U * U * U) + ControlPoint1 * (3.0 * U * U * T) + ControlPoint2 * (3.0 * U * T * T) + InPointB * (T * T * T);
 	}
 }
 
@@ -60,6 +99,12 @@ void UNodeEdge::SetEdgeType(const EEdgeType NewType)
 {
 	EdgeType = NewType;
 	UpdateEdgeColor();
+
+	// Types are Map Data, Selection Alone is Drawn Over the Raster
+	if (MapGenerator)
+	{
+		MapGenerator->MarkRasterDirty();
+	}
 }
 
 void UNodeEdge::SelectEdge()
@@ -76,71 +121,25 @@ void UNodeEdge::DeselectEdge()
 
 void UNodeEdge::UpdateEdgeColor()
 {
-	if (SelectionState == ESelectionState::Selected)
-	{
-		Color = FLinearColor::Red;
-	}
-	else
+	Color = SelectionState == ESelectionState::Selected ? FLinearColor::Red : GetTypeColor();
+
+	if (MapGenerator)
 	{
-		switch (EdgeType)
-		{
-		case EEdgeType::Road:
-			Color = FColor(50, 50, 50, 255); // Dark gray for roads
-			break;
-		case EEdgeType::River:
-			Color = FColor(0, 150, 255, 255); // Clear blue for rivers
-			break;
-		case EEdgeType::Cliff:
-			Color = FColor(100, 100, 100, 255); // Gray for cliffs
-			break;
-		default:
-			Color = FLinearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent for undefined edge types
-		}
+		MapGenerator->MarkEdgeBatchDirty();
 	}
 }
 
-//////////////////
-//  Event Logic //
-//////////////////
-
-int32 UNodeEdge::NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+FLinearColor UNodeEdge::GetTypeColor() const
 {
-	auto InContext = FPaintContext(AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
-
-	if (MapGenerator)
+	switch (EdgeType)
 	{
-		// Draw Edge
-		MapGenerator->DrawLines(InContext, AllottedGeometry, BezierCurvePoints, Color, 2);
-
-		// Draw Point A
-		if (bDrawA)
-		{
-			InContext.LayerId += 1;
-			MapGenerator->DrawPoint(InContext, AllottedGeometry, PointA, FLinearColor::Red, FVector2D(5, 5) * 2);
-		}
-
-		// Draw Point B
-		if (bDrawA)
-		{
-			InContext.LayerId += 1;
-			MapGenerator->DrawPoint(InContext, AllottedGeometry, PointB, FLinearColor::Red, FVector2D(5, 5) * 2);
-		}
+	case EEdgeType::Road:
+		return FColor(50, 50, 50, 255); // Dark gray for roads
+	case EEdgeType::River:
+		return FColor(0, 150, 255, 255); // Clear blue for rivers
+	case EEdgeType::Cliff:
+		return FColor(100, 100, 100, 255); // Gray for cliffs
+	default:
+		return FLinearColor(0.0f, 0.0f, 0.0f, 0.0f); // Transparent for undefined edge types
 	}
-
-	return Super::NativePaint(Args, AllottedGeometry, MyCullingRect, OutDrawElements, LayerId, InWidgetStyle, bParentEnabled);
 }
-
-////////////////////////////
-// Edge Calculation Logic //
-////////////////////////////
-
-bool UNodeEdge::IsPointInsideMap(const FVector2D& Point) const
-{
-	const FVector2D MapSize = MapGenerator->GetMapSize();
-
-	// Assuming the map's bottom left corner is at (0,0) and the top right corner is at (MapSize.X, MapSize.Y)
-	const bool bIsInsideX = Point.X >= 0 && Point.X <= MapSize.X;
-	const bool bIsInsideY = Point.Y >= 0 && Point.Y <= MapSize.Y;
-
-	return bIsInsideX && bIsInsideY;
-}
\ No newline at end of file
@@ -0,0 +1,120 @@
+/**
+ * @author Devin DeMatto
+ * @file SVoronoiMapView.cpp
+ */
+
+#include "SVoronoiMapView.h"
+#include "MapGeneration.h"
+#include "MapNode.h"
+
+void SVoronoiMapView::Construct(const FArguments& InArgs)
+{
+	Map = InArgs._Map;
+}
+
+/**
+ * Draws the Raster, a Pyramid Level or the Visible Tiles, Then the Overlays of Visible Nodes
+ * Everything lands on the map's fixed layers, the overlay layer is the highest one used
+ */
+int32 SVoronoiMapView::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const
+{
+	// Tiles Build Their Batches Lazily at the Band Being Drawn, so the Map Isn't Const Here
+	UMapGeneration* MapGen = Map.Get();
+	if (!MapGen)
+	{
+		return LayerId;
+	}
+
+	const FSlateRenderTransform MapToRender = MapGen->GetMapToRenderTransform(AllottedGeometry);
+	const int32 FillLayerId = UInteractiveMap::GetMapLayer(LayerId, EMapLayer::Fill);
+	const int32 OverlayLayerId = UInteractiveMap::GetMapLayer(LayerId, EMapLayer::Overlay);
+
+	// Zoomed Out Far Enough, the Whole Map Fill & Edges are One Textured Box
+	const bool bPaintRaster = MapGen->RasterTexture && !MapGen->bRasterDirty && !MapGen->PendingRaster.IsValid() && MapGen->bRasterHasEdges == MapGen->bDrawVoronoiEdges && MapGen->ShouldPaintRaster(AllottedGeometry);
+	if (bPaintRaster)
+	{
+		const FVector2D RasterMin = MapGen->TranslateToWidgetSpace(MapGen->RasterBounds.Min);
+		const FVector2D RasterMax = MapGen->TranslateToWidgetSpace(MapGen->RasterBounds.Max);
+		const FPaintGeometry RasterGeometry = AllottedGeometry.ToPaintGeometry(RasterMax - RasterMin, FSlateLayoutTransform(RasterMin));
+		FSlateDrawElement::MakeBox(OutDrawElements, FillLayerId, RasterGeometry, &MapGen->RasterBrush, ESlateDrawEffect::None, FLinearColor::White);
+	}
+
+	// Zoomed Out Views Draw a Coarser Graph in Place of Every Node
+	const int32 PaintLevel = MapGen->GetPaintLevel(AllottedGeometry);
+	const bool bPaintLevel = !bPaintRaster && PaintLevel > 0;
+	if (bPaintLevel)
+	{
+		MapGen->ForEachLevelBatch(PaintLevel, [&](const FMapMeshBatch& Batch) { Batch.Paint(OutDrawElements, FillLayerId, MapToRender); });
+	}
+
+	// The Raster & Levels Only Have Type Colors, Selection is Drawn Over Them
+	const bool bPaintTiles = !bPaintRaster && !bPaintLevel;
+	if (!bPaintTiles && MapGen->bDrawVoronoiEdges && !MapGen->SelectionLines.IsEmpty())
+	{
+		constexpr float EdgeThickness = 2.0f;
+		MapGen->SelectionLines.Paint(OutDrawElements, UInteractiveMap::GetMapLayer(LayerId, EMapLayer::Edges), MapToRender, EdgeThickness * AllottedGeometry.Scale);
+	}
+
+	// Only Tiles & Nodes Overlapping the View are Drawn, Nodes Only Paint Their Overlays
+	const FBox2D VisibleBounds = MapGen->GetVisibleMapBounds(AllottedGeometry, MyCullingRect);
+	if (!VisibleBounds.bIsValid)
+	{
+		MapGen->PaintOverlayPoints(OutDrawElements, OverlayLayerId, AllottedGeometry);
+		return OverlayLayerId;
+	}
+
+	const FPaintContext OverlayContext(AllottedGeometry, MyCullingRect, OutDrawElements, OverlayLayerId, InWidgetStyle, bParentEnabled);
+	const int32 Band = UMapGeneration::GetCurveBand(MapGen->GetPixelsPerUnit(AllottedGeometry));
+	for (FMapMeshTile& Tile : MapGen->CellTiles)
+	{
+		if (!Tile.Bounds.Intersect(VisibleBounds))
+		{
+			continue;
+		}
+
+		// Tessellation Follows How Long Each Edge is on Screen, Only the Band in View is Ever Built
+		if (bPaintTiles)
+		{
+			if (Tile.FillBand != Band)
+			{
+				MapGen->BuildTileFill(Tile, Band);
+			}
+			Tile.Fill.Paint(OutDrawElements, FillLayerId, MapToRender);
+		}
+
+		if (bPaintTiles && MapGen->bDrawVoronoiEdges)
+		{
+			if (Tile.LinesBand != Band)
+			{
+				MapGen->BuildTileLines(Tile, Band);
+			}
+
+			constexpr float EdgeThickness = 2.0f;
+			Tile.Lines.Paint(OutDrawElements, UInteractiveMap::GetMapLayer(LayerId, EMapLayer::Edges), MapToRender, EdgeThickness * AllottedGeometry.Scale);
+		}
+
+		if (MapGen->bDrawVoronoiCentroids)
+		{
+			Tile.Centroids.Paint(OutDrawElements, UInteractiveMap::GetMapLayer(LayerId, EMapLayer::Centroids), MapToRender, AllottedGeometry.Scale);
+		}
+
+		for (const int32 Cell : Tile.Cells)
+		{
+			const UMapNode* Node = MapGen->Nodes[Cell];
+			if (Node->GetBounds().Intersect(VisibleBounds))
+			{
+				Node->PaintOverlay(OverlayContext);
+			}
+		}
+	}
+
+	// Markers are Painted Here so a Cached Paint Keeps Them
+	MapGen->PaintOverlayPoints(OutDrawElements, OverlayLayerId, AllottedGeometry);
+	return OverlayLayerId;
+}
+
+// The View Fills Whatever Space the Map Widget Gives it
+FVector2D SVoronoiMapView::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D::ZeroVector;
+}
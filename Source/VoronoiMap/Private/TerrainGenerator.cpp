@@ -8,6 +8,7 @@
 #include "TerrainGenerator.h"
 #include "MapGeneration.h"
 #include "NodeEdge.h"
+#include "MapGraph.h"
 #include "Biomes.h"
 
 
@@ -23,14 +24,48 @@ void UTerrainGenerator::GenerateLand()
 	LandNodes.Empty();
 	LandEdges.Empty();
 
+	GenerateLandFrom(0);
+}
+
+/**
+ * Generates Terrain for Newly Appended Nodes Without Touching the Rest of the Map,
+ * Chunks Own Their Seam Edges so Nothing Resident Depends on the New Nodes
+ * @param FirstNode Index of the First Node Appended Since the Last Terrain Run
+ */
+void UTerrainGenerator::GenerateChunkTerrain(const int32 FirstNode)
+{
+	const int32 FirstLandNode = LandNodes.Num();
+	GenerateLandFrom(FirstNode);
+	GenerateCliffsFrom(FirstNode);
+	GenerateBiomesFrom(FirstLandNode);
+}
+
+// Pooled Objects Keep Stale Indices Until They're Reused, They Can't Stay in the Land Cache
+void UTerrainGenerator::ReleaseRemoved()
+{
+	LandNodes.RemoveAll([](const UMapNode* Node) { return Node->IsMarkedForRemoval(); });
+	LandEdges.RemoveAll([](const UNodeEdge* Edge) { return Edge->Index == INDEX_NONE; });
+}
+
+/**
+ * Samples Heights for Nodes From FirstNode Onwards & Caches the Ones Above Sea Level
+ * @param FirstNode Index of the First Node to Generate
+ */
+void UTerrainGenerator::GenerateLandFrom(const int32 FirstNode)
+{
 	// Set the simplex noise seed
 	USimplexNoiseBPLibrary::setNoiseSeed(TerrainSeed);
-	const FVector2D MapSize = MapGen->GetMapSize();
+	const bool bChunkedWorld = MapGen->IsChunkedWorld();
+	const FVector2D MapSize = bChunkedWorld ? MapGen->ChunkSize : MapGen->GetMapSize();
+
+	const TArray<UMapNode*>& Nodes = MapGen->GetNodes();
+	const int32 FirstLandNode = LandNodes.Num();
 
 	// Terrain Generation Noise
-	TArray<UMapNode*> Nodes = MapGen->GetNodes();
-	for (UMapNode* Node : Nodes)
+	for (int32 Index = FirstNode; Index < Nodes.Num(); ++Index)
 	{
+		UMapNode* Node = Nodes[Index];
+
 		// Decrease the divisor to increase the scale of noise features
 		const float NoiseX = Node->GetCentroid().X / (MapSize.X / 3); // Larger divisor = smaller features
 		const float NoiseY = Node->GetCentroid().Y / (MapSize.Y / 3);
@@ -44,6 +79,12 @@ void UTerrainGenerator::GenerateLand()
 		const float GradientY = FMath::Abs(Node->GetCentroid().Y - MapSize.Y / 2) / (MapSize.Y / 2);
 		float SquareGradient = FMath::Max(GradientX, GradientY);
 
+		// Chunked Worlds Aren't an Island, Land Continues in Every Direction
+		if (bChunkedWorld)
+		{
+			SquareGradient = 0.0f;
+		}
+
 		// Lower power for a softer gradient
 		SquareGradient = FMath::Pow(SquareGradient, 1.0f);
 
@@ -61,22 +102,41 @@ void UTerrainGenerator::GenerateLand()
 		}
 	}
 
-	// Cache Edges
-	TSet<UNodeEdge*> UniqueEdges;
-	for (UMapNode* Node : LandNodes)
+	// Cache Edges, Each Edge is Owned by the Lowest Indexed Land Node on it so it's Only Added Once
+	const TArray<FMapEdgeNodes>& EdgeNodes = MapGen->GetEdgeNodes();
+	for (int32 LandIndex = FirstLandNode; LandIndex < LandNodes.Num(); ++LandIndex)
 	{
+		const UMapNode* Node = LandNodes[LandIndex];
 		for (UNodeEdge* Edge : Node->Edges)
 		{
-			if (!LandEdges.Contains(Edge)) { LandEdges.Add(Edge); }
+			const FMapEdgeNodes& Pair = EdgeNodes[Edge->Index];
+			const int32 Self = Nodes[Pair.Nodes[0]] == Node ? Pair.Nodes[0] : Pair.Nodes[1];
+			const int32 Other = Pair.Nodes[0] == Self ? Pair.Nodes[1] : Pair.Nodes[0];
+
+			const bool bOtherOwnsEdge = Other != INDEX_NONE && Other < Self && Nodes[Other]->GetHeight() > SeaLevel;
+			if (!bOtherOwnsEdge)
+			{
+				LandEdges.Add(Edge);
+			}
 		}
 	}
 }
 
 void UTerrainGenerator::GenerateBiomes() {
-	const FVector2D MapSize = MapGen->GetMapSize();
+	GenerateBiomesFrom(0);
+}
+
+/**
+ * Assigns Biomes to Cached Land Nodes From FirstLandNode Onwards
+ * @param FirstLandNode Index Into LandNodes of the First Node to Assign
+ */
+void UTerrainGenerator::GenerateBiomesFrom(const int32 FirstLandNode) {
+	const FVector2D MapSize = MapGen->IsChunkedWorld() ? MapGen->ChunkSize : MapGen->GetMapSize();
 	USimplexNoiseBPLibrary::setNoiseSeed(BiomeSeed);
 
-	for (UMapNode* Node : LandNodes) {
+	for (int32 LandIndex = FirstLandNode; LandIndex < LandNodes.Num(); ++LandIndex) {
+		UMapNode* Node = LandNodes[LandIndex];
+
 		// Scale the coordinates for the noise function
 		const float NoiseX = Node->GetCentroid().X / (MapSize.X / 2.0f);
 		const float NoiseY = Node->GetCentroid().Y / (MapSize.Y / 2.0f);
@@ -127,26 +187,111 @@ EBiomeType UTerrainGenerator::DetermineBiome(const UMapNode* Node, const float M
 
 void UTerrainGenerator::GenerateCliffs()
 {
+	// Clear Cliffs From a Previous Run, Land or CliffDiff May Have Changed Since
+	for (UNodeEdge* Edge : MapGen->GetEdges())
+	{
+		if (Edge->EdgeType == EEdgeType::Cliff)
+		{
+			Edge->SetEdgeType(EEdgeType::None);
+		}
+	}
+
+	// Heights Shifted by One Slot, an Empty Edge Slot (INDEX_NONE) Reads Sea Level
+	const TArray<UMapNode*>& Nodes = MapGen->GetNodes();
+	TArray<float> Heights;
+	Heights.SetNumUninitialized(Nodes.Num() + 1);
+	Heights[0] = SeaLevel;
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		Heights[Index + 1] = Nodes[Index]->GetHeight();
+	}
+
+	// Chunk Seams Aren't Coastline
+	const bool bCoastCanBeCliff = !MapGen->IsChunkedWorld();
+	const TArray<FMapEdgeNodes>& EdgeNodes = MapGen->GetEdgeNodes();
+
 	// Loop Through Edges And Find Cliffs
 	for (UNodeEdge* Edge : LandEdges)
 	{
-		float HeightDiff = 0;
+		const FMapEdgeNodes& Pair = EdgeNodes[Edge->Index];
 
-		if (Edge->Nodes.Num() == 2) // Check if there are two nodes
-		{
-			// Calculate the height difference between the two nodes
-			HeightDiff = FMath::Abs(Edge->Nodes[0]->GetHeight() - Edge->Nodes[1]->GetHeight());
-		}
-		else if (Edge->Nodes.Num() == 1) // Check if there is only one node
-		{
-			// Calculate the height difference between the node and sea level
-			HeightDiff = Edge->Nodes[0]->GetHeight() - SeaLevel;
-		}
+		// Height difference between the two nodes, or between the node and sea level
+		const float HeightDiff = FMath::Abs(Heights[Pair.Nodes[0] + 1] - Heights[Pair.Nodes[1] + 1]);
 
 		// Check if the node's height exceeds sea level by CliffDiff or more
-		if (HeightDiff >= CliffDiff)
+		if (HeightDiff >= CliffDiff && (bCoastCanBeCliff || Pair.IsShared()))
 		{
 			Edge->SetEdgeType(EEdgeType::Cliff);
 		}
 	}
-}
\ No newline at end of file
+}
+
+/**
+ * Evaluates Cliffs on Every Edge of Nodes From FirstNode Onwards
+ * @param FirstNode Index of the First Node Appended Since the Last Terrain Run
+ */
+void UTerrainGenerator::GenerateCliffsFrom(const int32 FirstNode)
+{
+	const TArray<UMapNode*>& Nodes = MapGen->GetNodes();
+	const TArray<FMapEdgeNodes>& EdgeNodes = MapGen->GetEdgeNodes();
+	const bool bCoastCanBeCliff = !MapGen->IsChunkedWorld();
+
+	// An Empty Edge Slot (INDEX_NONE) Reads Sea Level
+	const auto GetHeight = [this, &Nodes](const int32 NodeIndex)
+	{
+		return NodeIndex != INDEX_NONE ? Nodes[NodeIndex]->GetHeight() : SeaLevel;
+	};
+
+	for (int32 Index = FirstNode; Index < Nodes.Num(); ++Index)
+	{
+		for (UNodeEdge* Edge : Nodes[Index]->Edges)
+		{
+			const FMapEdgeNodes& Pair = EdgeNodes[Edge->Index];
+			const float HeightA = GetHeight(Pair.Nodes[0]);
+			const float HeightB = GetHeight(Pair.Nodes[1]);
+
+			// Only Edges in the Land Cache Can be Cliffs, Matching GenerateCliffs
+			const bool bIsLandEdge = HeightA > SeaLevel || HeightB > SeaLevel;
+			const bool bIsCliff = bIsLandEdge && FMath::Abs(HeightA - HeightB) >= CliffDiff && (bCoastCanBeCliff || Pair.IsShared());
+
+			if (bIsCliff)
+			{
+				Edge->SetEdgeType(EEdgeType::Cliff);
+			}
+			else if (Edge->EdgeType == EEdgeType::Cliff)
+			{
+				Edge->SetEdgeType(EEdgeType::None);
+			}
+		}
+	}
+}
+
+//////////////////////
+// Parameter Hashes //
+//////////////////////
+
+// Inputs of GenerateLand
+uint32 UTerrainGenerator::GetLandParameterHash() const
+{
+	uint32 Hash = GetTypeHash(TerrainSeed);
+	Hash = HashCombine(Hash, GetTypeHash(MaxHeight));
+	Hash = HashCombine(Hash, GetTypeHash(SeaLevel));
+	Hash = HashCombine(Hash, GetTypeHash(TerrainLacunarity));
+	Hash = HashCombine(Hash, GetTypeHash(TerrainPersistence));
+	return HashCombine(Hash, GetTypeHash(TerrainOctaves));
+}
+
+// Inputs of GenerateCliffs
+uint32 UTerrainGenerator::GetCliffParameterHash() const
+{
+	return HashCombine(GetTypeHash(CliffDiff), GetTypeHash(SeaLevel));
+}
+
+// Inputs of GenerateBiomes
+uint32 UTerrainGenerator::GetBiomeParameterHash() const
+{
+	uint32 Hash = GetTypeHash(BiomeSeed);
+	Hash = HashCombine(Hash, GetTypeHash(MoistureLacunarity));
+	Hash = HashCombine(Hash, GetTypeHash(MoisturePersistence));
+	return HashCombine(Hash, GetTypeHash(MoistureOctaves));
+}
@@ -0,0 +1,38 @@
+/**
+ * Headless Batch Map Generation
+ * @author Devin DeMatto
+ * @file GenerateMapsCommandlet.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GenerateMapsCommandlet.generated.h"
+
+class UMapGeneration;
+
+/**
+ * Generates Maps From a List of Seeds & Writes Each One to Disk as JSON
+ *
+ * -run=GenerateMaps [-Seeds=1,2,3 | -SeedFile=Path | -Count=N -FirstSeed=S] [-Output=Dir] [-Workers=N]
+ * Any editable UMapGeneration or UTerrainGenerator property can be set by name, e.g. -Spacing=20 -SeaLevel=150
+ */
+UCLASS()
+class VORONOIMAP_API UGenerateMapsCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/// Constructor
+	explicit UGenerateMapsCommandlet(const FObjectInitializer& ObjectInitializer);
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	static TArray<int32> ParseSeeds(const FString& Params);
+
+	static void ApplyOverrides(UObject* Object, const FString& Params);
+
+	static bool SaveMap(UMapGeneration* MapGen, int32 Seed, const FString& FilePath);
+};
@@ -7,8 +7,22 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "MapMeshBatch.h"
 #include "InteractiveMap.generated.h"
 
+/**
+ * Fixed Layers the Whole Map Paints on, as Offsets From the LayerId the Map is Painted at
+ * Slate only merges elements sharing a layer, keeping the set small keeps draw calls independent of the node count
+ */
+enum class EMapLayer : int32
+{
+	Fill,
+	Edges,
+	Centroids,
+	Overlay,
+	Num
+};
+
 /**
  * Base Class for Interactive Map
  */
@@ -47,11 +61,11 @@ protected:
 	bool ZoomLimitsEnabled = true;
 
 	// Show Widget Border?
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapViewer Graphics")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetShowWidgetBorder, Category = "MapViewer Graphics")
 	bool ShowWidgetBorder = false;
 
 	// Show Map Center?
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapViewer Graphics")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetShowMapCenter, Category = "MapViewer Graphics")
 	bool ShowMapCenter = true;
 
 	// Mouse Position in Virtual Space
@@ -72,6 +86,9 @@ private:
 	// Are we currently moving the viewport
 	bool bIsPanning = false;
 
+	// Markers Queued by DrawPoint This Paint, Drawn Together on the Overlay Layer
+	mutable FMapPointBatch OverlayPoints;
+
 	///////////
 	// Logic //
 	///////////
@@ -79,6 +96,12 @@ private:
 	void UpdateViewportSize();
 	void RepositionViewportIfNeeded();
 
+protected:
+	// Draws & Clears the Markers Queued by DrawPoint, Whoever Queued Them Paints Them so They're Cached Together
+	void PaintOverlayPoints(FSlateWindowElementList& OutDrawElements, int32 LayerId, const FGeometry& AllottedGeometry) const;
+
+private:
+
 	///////////////////////////
 	// Drawing Functionality // 
 	///////////////////////////
@@ -90,6 +113,14 @@ public:
 	FVector2D TranslateToWidgetSpace(const FVector2D& VirtualPoint) const;
 	FVector2D TranslateToVirtualSpace(const FVector2D& ScreenPoint) const;
 
+	// TranslateToWidgetSpace as a Single Affine Transform
+	FSlateRenderTransform GetMapToWidgetTransform() const;
+
+	FSlateRenderTransform GetMapToRenderTransform(const FGeometry& AllottedGeometry) const;
+
+	// LayerId of One of the Map's Fixed Layers
+	static int32 GetMapLayer(const int32 BaseLayerId, const EMapLayer Layer) { return BaseLayerId + static_cast<int32>(Layer); }
+
 	/////////////////////
 	// Setters/Getters //
 	/////////////////////
@@ -102,19 +133,27 @@ public:
 
 	FVector2D GetMousePositionInVirtualSpace() const { return MousePositionInVirtualSpace; }
 
+	UFUNCTION(BlueprintSetter)
+	void SetShowWidgetBorder(bool bInShowWidgetBorder);
+
+	UFUNCTION(BlueprintSetter)
+	void SetShowMapCenter(bool bInShowMapCenter);
+
+	// The Widget Isn't Volatile, Anything Changing What the Map Shows Must Call This to Get it Repainted
+	virtual void InvalidateMap();
+
 	/////////////////////////////////////////////////
 	// Drawing Functionality Called to Draw to Map //
 	/////////////////////////////////////////////////
 
-	void DrawPoint(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const FVector2D& VirtualPoint,
-				   const FLinearColor& Color, const FVector2D Size) const;
+	void DrawPoint(const FVector2D& VirtualPoint, const FLinearColor& Color, const FVector2D Size) const;
 
 	void DrawLine(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const FVector2D& VirtualStartPoint,
 				  const FVector2D& VirtualEndPoint, const FLinearColor& Color, const double Thickness) const;
 
-	void DrawLines(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const TArray<FVector2D>& Points, const FLinearColor& Color, const double Thickness) const;
+	void DrawLines(const FPaintContext& InContext, const FGeometry& AllottedGeometry, TArrayView<const FVector2D> Points, const FLinearColor& Color, const double Thickness) const;
 
-	void DrawPolygon(const FPaintContext& InContext, const FGeometry& AllottedGeometry, const TArray<FVector2D>& Vertices, const TArray<
+	void DrawPolygon(const FPaintContext& InContext, const FGeometry& AllottedGeometry, TArrayView<const FVector2D> Vertices, const TArray<
 					 SlateIndex>
 					 & Indices, const FColor& Color) const;
 
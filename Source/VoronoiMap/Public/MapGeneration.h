@@ -8,13 +8,41 @@
 
 #include "CoreMinimal.h"
 #include "InteractiveMap.h"
+#include "MapGraph.h"
+#include "MapGraphPyramid.h"
+#include "MapMeshBatch.h"
+#include "MapRaster.h"
+#include "MapSiteIndex.h"
+#include "Async/Future.h"
 #include "MapGeneration.generated.h"
 
 class UNodeEdge;
 class UMapNode;
-struct FDelaunayMesh;
 
 class UTerrainGenerator;
+class UTexture2D;
+class SVoronoiMapView;
+
+/**
+ * Nodes Owned by a Resident Chunk of the World
+ */
+USTRUCT()
+struct FMapChunk
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<UMapNode*> Nodes;
+
+	// Coarser Graphs Over This Chunk's Nodes Alone, so Streaming Only Builds Pyramids for Chunks That Load
+	FMapGraphPyramid Pyramid;
+
+	// Fill of Every Cell on Each Pyramid Level, Index Aligned With Levels
+	TArray<FMapMeshBatch> LevelBatches;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnMapGenerationProgress, EMapGenerationStage, Stage, float, Progress);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnMapGenerationFinished, bool, bCompleted);
 
 /**
  * Map Generation Class
@@ -30,15 +58,15 @@ public:
 	UMapNode* SelectedNode = nullptr;
 
 	// Should We Draw Node Edges
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Stats")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetDrawVoronoiEdges, Category = "MapGeneration Stats")
 	bool bDrawVoronoiEdges = true;
 
 	// Should we Draw Nodes Association to Neighbors
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Stats")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetDrawDelaunayTriangles, Category = "MapGeneration Stats")
 	bool bDrawDelaunayTriangles = true;
 
 	// Should we Draw Node Centroid
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Stats")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetDrawVoronoiCentroids, Category = "MapGeneration Stats")
 	bool bDrawVoronoiCentroids = true;
 
 	/////////////////////////////////////////////////
@@ -57,24 +85,80 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Parameters")
 	int Spacing = 35;
 
+	// Build Nodes, Edges and Meshes Across Worker Threads
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Parameters")
+	bool bParallelGeneration = true;
+
+	///////////////////////////
+	// Define LOD Pyramid Use //
+	///////////////////////////
+
+	// Draw Coarser Graphs When Zoomed Out Far Enough That Cells Get Tiny
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetUseLODPyramid, Category = "MapGeneration LOD")
+	bool bUseLODPyramid = true;
+
+	// Smallest On-Screen Cell Size (in Pixels) Before Switching to a Coarser Level
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMinLODCellPixels, Category = "MapGeneration LOD")
+	float MinLODCellPixels = 8.0f;
+
+	// Shortest On-Screen Curve Segment (in Pixels) Before Edges Drop to a Coarser Tessellation
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetMinCurveSegmentPixels, Category = "MapGeneration LOD")
+	float MinCurveSegmentPixels = 4.0f;
+
+	// Draw a Texture of the Whole Map Until Zooming in Past its Resolution (Not Used for Chunked Worlds)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetUseRasterCache, Category = "MapGeneration LOD")
+	bool bUseRasterCache = true;
+
+	// Texture Size Along the Map's Longer Side
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetRasterResolution, Category = "MapGeneration LOD")
+	int32 RasterResolution = 2048;
+
+	////////////////////////////////
+	// Define Chunked World Setup //
+	////////////////////////////////
+
+	// Generate an Unbounded World Chunk by Chunk Around the Viewport (Disable PanningLimitsEnabled to Explore it)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Chunks")
+	bool bChunkedWorld = false;
+
+	// Size of Each Chunk in Map Space
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Chunks")
+	FVector2D ChunkSize = FVector2D(500, 500);
+
+	// Chunks Kept Resident Beyond the Ones the Viewport Touches
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Chunks")
+	int ChunkLoadRadius = 1;
+
+	// Seed Every Chunk Samples its Points From, Chunks Look the Same Each Time They Load
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "MapGeneration Chunks")
+	int WorldSeed = 0;
+
 	/// Constructor   
 	explicit UMapGeneration(const FObjectInitializer& ObjectInitializer) : UInteractiveMap(ObjectInitializer) {};
 
 	virtual void NativeConstruct() override;
+	virtual void NativeDestruct() override;
 
 	// Generator Modules
 	UPROPERTY(BlueprintReadWrite, Category = "MapGeneration Module")
 	UTerrainGenerator* TerrainGen = nullptr;
 
+	// Called as Generation Moves Through Each Stage
+	UPROPERTY(BlueprintAssignable, Category = "MapGeneration Events")
+	FOnMapGenerationProgress OnGenerationProgress;
+
+	// Called Once Asynchronous Generation Completes or is Cancelled
+	UPROPERTY(BlueprintAssignable, Category = "MapGeneration Events")
+	FOnMapGenerationFinished OnGenerationFinished;
+
 	//////////////////
 	//  Event Logic //
 	//////////////////
 
-	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
-		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
-	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	virtual void NativeTick(const FGeometry& MyGeometry, float InDeltaTime) override;
+	virtual void ReleaseSlateResources(bool bReleaseChildren) override;
+	virtual void InvalidateMap() override;
 	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
-	virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
 
 	////////////////////
 	// Public Methods //
@@ -83,6 +167,29 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
 	void GenerateMap();
 
+	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
+	void GenerateMapAsync();
+
+	// Re-Runs Only the Stages Whose Parameters Changed Since They Last Ran
+	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
+	void RegenerateMap();
+
+	// Forces Stages to Run on the Next RegenerateMap
+	void MarkStagesDirty(EMapDirtyStage Stages) { DirtyStages |= Stages; }
+
+	void ApplyGraph(const FMapGraphSettings& Settings, FMapGraphData& Graph);
+
+	// Snapshot of Parameters Handed to the Graph Builder
+	FMapGraphSettings MakeGraphSettings() const;
+
+	void InitializeModules();
+
+	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
+	void CancelGeneration();
+
+	UFUNCTION(BlueprintPure, Category = "MapGeneration")
+	bool IsGenerating() const { return ActiveTask.IsValid(); }
+
 	UFUNCTION(BlueprintPure, Category = "MapGeneration")
 	UMapNode* GetSelectedNode() const { return SelectedNode; }
 
@@ -90,30 +197,252 @@ public:
 
 	void SetSelectedNode(UMapNode* Node);
 
+	UFUNCTION(BlueprintSetter)
+	void SetDrawVoronoiEdges(bool bInDrawVoronoiEdges);
+
+	UFUNCTION(BlueprintSetter)
+	void SetDrawDelaunayTriangles(bool bInDrawDelaunayTriangles);
+
+	UFUNCTION(BlueprintSetter)
+	void SetDrawVoronoiCentroids(bool bInDrawVoronoiCentroids);
+
+	UFUNCTION(BlueprintSetter)
+	void SetUseLODPyramid(bool bInUseLODPyramid);
+
+	UFUNCTION(BlueprintSetter)
+	void SetMinLODCellPixels(float InMinLODCellPixels);
+
+	UFUNCTION(BlueprintSetter)
+	void SetMinCurveSegmentPixels(float InMinCurveSegmentPixels);
+
+	UFUNCTION(BlueprintSetter)
+	void SetUseRasterCache(bool bInUseRasterCache);
+
+	UFUNCTION(BlueprintSetter)
+	void SetRasterResolution(int32 InRasterResolution);
+
+	// Node Whose Drawn Cell Contains a Point in Map Space, Null if None Does
+	UMapNode* FindNodeUnderPoint(const FVector2D& Point) const;
+
+	// Node Whose Voronoi Cell Contains a Point in Map Space, the One With the Nearest Centroid
+	UFUNCTION(BlueprintPure, Category = "MapGeneration Queries")
+	UMapNode* FindNodeAt(FVector2D Point) const;
+
+	// Nodes With the Count Nearest Centroids to a Point in Map Space, Nearest First
+	UFUNCTION(BlueprintPure, Category = "MapGeneration Queries")
+	TArray<UMapNode*> FindKNearest(FVector2D Point, int32 Count) const;
+
 	TArray<UMapNode*>& GetNodes() { return Nodes; }
 
+	TArray<UNodeEdge*>& GetEdges() { return Edges; }
+
+	// Voronoi Vertices Shared by All Edges
+	const TArray<FVector2D>& GetVertices() const { return Vertices; }
+
+	// Bezier Points of Every Edge, Edges & Nodes Reference Ranges of it
+	const TArray<FVector2D>& GetCurvePoints() const { return CurvePoints; }
+
+	// Cell Colors or Shapes Changed, the Batched Fill is Rebuilt Before the Next Paint
+	void MarkCellBatchDirty() { bCellBatchDirty = true; }
+
+	// Edge Colors Changed, Only the Batched Edge Lines are Rebuilt Before the Next Paint
+	void MarkEdgeBatchDirty() { bEdgeBatchDirty = true; }
+
+	// Map Data Drawn Into the Raster Cache Changed, Selection Doesn't Count
+	void MarkRasterDirty() { bRasterDirty = true; }
+
+	// Node Index Pairs, Aligned With GetEdges()
+	const TArray<FMapEdgeNodes>& GetEdgeNodes() const { return EdgeNodes; }
+
+	UMapNode* GetEdgeNode(const int32 EdgeIndex, const int32 Slot) const
+	{
+		const int32 NodeIndex = EdgeNodes[EdgeIndex].Nodes[Slot];
+		return NodeIndex != INDEX_NONE ? Nodes[NodeIndex] : nullptr;
+	}
+
+	bool IsChunkedWorld() const { return bChunkedWorld; }
+
+	// Coarser Graphs Over the Current Nodes, Suited to World-Scale Queries
+	const FMapGraphPyramid& GetPyramid() const { return Pyramid; }
+
+	// Loads Chunks Near the Viewport & Unloads the Rest
+	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
+	void UpdateResidentChunks();
+
+	// Releases Pooled Nodes & Edges so They Can be Garbage Collected
+	UFUNCTION(BlueprintCallable, Category = "MapGeneration")
+	void EmptyPools();
+
+protected:
+	// Puts the Map View Beneath Whatever Content the Widget Lays Out
+	virtual TSharedRef<SWidget> RebuildWidget() override;
+
 private:
+	// Paints & Hit-Tests Straight From the Batches, Nodes & Edges Below
+	friend class SVoronoiMapView;
+
+	TSharedPtr<SVoronoiMapView> MapView;
 
 	// Stores all Voronoi Nodes
 	UPROPERTY()
 	TArray<UMapNode*> Nodes;
 
+	// Stores all Voronoi Edges
+	UPROPERTY()
+	TArray<UNodeEdge*> Edges;
+
+	// Voronoi Vertex Pool, Edges Reference Their Endpoints by Index
+	TArray<FVector2D> Vertices;
+
+	// Bezier Points of Every Edge, Laid Out in Edge Order so Compaction Only Moves Ranges Down
+	TArray<FVector2D> CurvePoints;
+
+	// Nodes on Either Side of Each Edge, Index Aligned With Edges
+	TArray<FMapEdgeNodes> EdgeNodes;
+
+	// Nodes Kept From Previous Generations, Recycled Before Allocating New Ones
+	UPROPERTY()
+	TArray<UMapNode*> NodePool;
+
+	// Edges Kept From Previous Generations, Recycled Before Allocating New Ones
+	UPROPERTY()
+	TArray<UNodeEdge*> EdgePool;
+
+	// Grid Over Node Centroids, Index Aligned With Nodes
+	FMapSiteIndex SiteIndex;
+
+	// Coarser Graphs Over the Current Nodes
+	FMapGraphPyramid Pyramid;
+
+	// Nodes Changed Since the Pyramid Was Built
+	bool bPyramidDirty = true;
+
+	// Fill of Every Node, One Draw Element Per Tile in View
+	TArray<FMapMeshTile> CellTiles;
+
+	// Node Shapes or Colors Changed Since CellTiles Were Built
+	bool bCellBatchDirty = true;
+
+	// Edge Types or Selection Changed Since the Tiles' Lines Were Built
+	bool bEdgeBatchDirty = true;
+
+	// Tiles Span This Many Node Spacings Along Each Side
+	static constexpr int32 CellsPerTile = 16;
+
+	// Selected Edges at Full Detail, Drawn Over the Raster so Selecting Never Re-Rasterizes
+	FMapLineBatch SelectionLines;
+
+	// Every Node & Edge Rasterized in Their Type Colors, Refreshed When Map Data Changes
+	UPROPERTY(Transient)
+	UTexture2D* RasterTexture = nullptr;
+
+	// Brush Pointing at RasterTexture
+	FSlateBrush RasterBrush;
+
+	// Map Space Box the Texture Covers
+	FBox2D RasterBounds = FBox2D(ForceInit);
+
+	// Texture Pixels Per Map Unit, Vectors are Drawn Once the Screen Gets Denser
+	double RasterTexelsPerUnit = 0.0;
+
+	// Node Shapes, Colors or Edge Types Changed Since the Texture Was Rasterized
+	bool bRasterDirty = true;
+
+	// Whether Edges Were Rasterized, the Texture is Redone When bDrawVoronoiEdges Changes
+	bool bRasterHasEdges = false;
+
+	// Pixels Being Drawn on a Worker, Vectors are Painted Until They're Uploaded
+	TFuture<FMapRaster> PendingRaster;
+
+	// Fill of Every Cell on Each Pyramid Level, Index Aligned With Levels
+	TArray<FMapMeshBatch> LevelBatches;
+
+	// Chunks Currently in Memory
 	UPROPERTY()
-	// Temporarily Holds Invalid Nodes
-	TArray<UMapNode*> InvalidNodes;
+	TMap<FIntPoint, FMapChunk> Chunks;
+
+	// Chunk Range Resident Chunks Were Last Updated For
+	FIntRect ResidentChunkRect;
 
 	// Generate Margin Around Map For Clipping
 	FVector2D BoundaryOffset = FVector2D(150, 150);
 
+	// Asynchronous Generation in Flight
+	TSharedPtr<FMapGenerationTask, ESPMode::ThreadSafe> ActiveTask;
+
+	// Completes With False if the Task was Cancelled
+	TFuture<bool> PendingGraphResult;
+
+	// Last Stage Sent to OnGenerationProgress
+	EMapGenerationStage LastReportedStage = EMapGenerationStage::Complete;
+
+	// Stages Explicitly Invalidated Since They Last Ran
+	EMapDirtyStage DirtyStages = EMapDirtyStage::All;
+
+	// Parameter Hashes Each Stage Last Ran With
+	uint32 AppliedGraphHash = 0;
+	uint32 AppliedLandHash = 0;
+	uint32 AppliedCliffHash = 0;
+	uint32 AppliedBiomeHash = 0;
+
 	////////////////////////////
 	// Map Generation Methods //
 	////////////////////////////
 
-	TArray<FVector2D> GeneratePoints() const;
+	void TickGeneration();
+
+	void BroadcastProgress(EMapGenerationStage Stage);
+
+	EMapDirtyStage GetChangedStages() const;
 
-	void GenerateGraph();
+	void RunTerrainStages(EMapDirtyStage Stages);
 
-	void RelateGraph(const FDelaunayMesh&, const TArray<FVector2D>& Points);
+	void GenerateGraph(FMapGraphData& Graph);
+
+	void AppendGraph(FMapGraphData& Graph);
+
+	void RelateGraph(FMapGraphData& Graph);
+
+	FIntRect GetDesiredChunkRect() const;
+
+	void RecycleGraph();
 
 	void ProcessInvalidNodes();
+
+	void RefreshPyramid();
+
+	void RefreshChunkPyramid(const FIntPoint& Coordinates, FMapChunk& Chunk);
+
+	static TArray<FVector2D> GetCentroids(const TArray<UMapNode*>& PyramidNodes);
+
+	static void UpdateLevelBatches(const TArray<UMapNode*>& PyramidNodes, FMapGraphPyramid& LevelPyramid, TArray<FMapMeshBatch>& OutLevelBatches);
+
+	void RebuildCellBatch();
+
+	void RebuildEdgeBatch();
+
+	double GetPixelsPerUnit(const FGeometry& AllottedGeometry) const;
+
+	int32 GetPaintLevel(const FGeometry& AllottedGeometry) const;
+
+	void ForEachLevelBatch(int32 Level, TFunctionRef<void(const FMapMeshBatch&)> Visitor) const;
+
+	int32 GetCurveLOD(double EdgePixels) const;
+
+	static int32 GetCurveBand(double PixelsPerUnit);
+
+	int32 GetEdgeCurveLOD(const UNodeEdge* Edge, int32 Band) const;
+
+	void BuildTileFill(FMapMeshTile& Tile, int32 Band) const;
+
+	void BuildTileLines(FMapMeshTile& Tile, int32 Band) const;
+
+	FBox2D GetVisibleMapBounds(const FGeometry& AllottedGeometry, const FSlateRect& CullingRect) const;
+
+	void RebuildRaster();
+
+	void UploadRaster(const FMapRaster& Raster);
+
+	bool ShouldPaintRaster(const FGeometry& AllottedGeometry) const;
+
 };
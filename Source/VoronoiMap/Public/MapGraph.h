@@ -0,0 +1,193 @@
+/**
+ * Plain Data Voronoi Graph, Safe to Build Away From the Game Thread
+ * @author Devin DeMatto
+ * @file MapGraph.h
+ */
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "MapGraph.generated.h"
+
+struct FDelaunayMesh;
+enum class EParallelForFlags;
+
+/**
+ * Stages of the Map Generation Pipeline
+ */
+UENUM(BlueprintType)
+enum class EMapGenerationStage : uint8
+{
+	Points UMETA(DisplayName = "Points"),
+	Triangulation UMETA(DisplayName = "Triangulation"),
+	Graph UMETA(DisplayName = "Graph"),
+	Mesh UMETA(DisplayName = "Mesh"),
+	Terrain UMETA(DisplayName = "Terrain"),
+	Complete UMETA(DisplayName = "Complete")
+};
+
+/**
+ * Pipeline Stages That are Invalidated Independently by Parameter Changes
+ */
+enum class EMapDirtyStage : uint8
+{
+	None = 0,
+	Graph = 1 << 0, // Points, Triangulation, Graph & Mesh
+	Land = 1 << 1,
+	Cliffs = 1 << 2,
+	Biomes = 1 << 3,
+	All = Graph | Land | Cliffs | Biomes
+};
+ENUM_CLASS_FLAGS(EMapDirtyStage);
+
+/**
+ * Snapshot of Generation Parameters, Taken on the Game Thread
+ */
+struct VORONOIMAP_API FMapGraphSettings
+{
+	// Size of Map Nodes are Kept Within
+	FVector2D MapSize = FVector2D::ZeroVector;
+
+	// Margin Around Map For Clipping
+	FVector2D BoundaryOffset = FVector2D::ZeroVector;
+
+	// Poisson Disk Sampling Parameters
+	int32 Iterations = 20;
+	int32 K = 5;
+	int32 Spacing = 35;
+
+	// Seed for Point Sampling
+	int32 Seed = 0;
+
+	// Chunked World, Each Chunk Samples its Own Points From Seed & its Coordinates
+	bool bChunked = false;
+	FVector2D ChunkSize = FVector2D(500, 500);
+
+	// Spread Work Across Worker Threads
+	bool bParallel = true;
+
+	// Hash of the Parameters That Change the Graph's Shape (Seed Excluded Unless Chunked)
+	uint32 GetParameterHash() const;
+
+	// Map Space Bounds Check, Chunked Worlds Have no Border
+	bool IsPointInsideMap(const FVector2D& Point) const;
+};
+
+/**
+ * Voronoi Edge Between Two Circumcenters
+ */
+struct VORONOIMAP_API FMapGraphEdge
+{
+	// Circumcenter A, Index Into FMapGraphData::Vertices
+	int32 VertexA = INDEX_NONE;
+
+	// Circumcenter B, Index Into FMapGraphData::Vertices
+	int32 VertexB = INDEX_NONE;
+
+	// Sites on Either Side of the Edge
+	int32 NodeA = INDEX_NONE;
+	int32 NodeB = INDEX_NONE;
+
+	// Range of FMapGraphData::CurvePoints Making up the BezierCurve, Runs From VertexA to VertexB
+	int32 CurveStart = 0;
+	int32 CurveNum = 0;
+
+	// Both Endpoints Inside the Map
+	bool bIsEdgeInsideMap = false;
+
+	// Exactly One Endpoint Inside the Map
+	bool bIsPartiallyInMap = false;
+
+	// Chunk Seam Edge Whose Other Copy Belongs to the Lower Chunk, Which Draws the Line
+	bool bIsSeamCopy = false;
+};
+
+/**
+ * Node Indices on Either Side of an Edge, Filled Slots Come First & INDEX_NONE Marks an Empty One
+ */
+struct VORONOIMAP_API FMapEdgeNodes
+{
+	int32 Nodes[2] = { INDEX_NONE, INDEX_NONE };
+
+	FMapEdgeNodes() = default;
+
+	FMapEdgeNodes(const int32 NodeA, const int32 NodeB)
+	{
+		Nodes[0] = NodeA != INDEX_NONE ? NodeA : NodeB;
+		Nodes[1] = NodeA != INDEX_NONE ? NodeB : INDEX_NONE;
+	}
+
+	bool IsEmpty() const { return Nodes[0] == INDEX_NONE; }
+	bool IsShared() const { return Nodes[1] != INDEX_NONE; }
+};
+
+/**
+ * Result of the Pure Data Stages (Points -> Delaunay -> Graph)
+ */
+struct VORONOIMAP_API FMapGraphData
+{
+	// Site of Each Node, in Map Space
+	TArray<FVector2D> Sites;
+
+	// Voronoi Vertices, One Per Delaunay Triangle Circumcenter
+	TArray<FVector2D> Vertices;
+
+	// Unique Voronoi Edges
+	TArray<FMapGraphEdge> Edges;
+
+	// Bezier Points of Every Edge, Each Edge Owns One Contiguous Range
+	TArray<FVector2D> CurvePoints;
+
+	// Edge Indices of Each Site, in Circulation Order so Consecutive Edges Share a Vertex
+	TArray<TArray<int32>> SiteEdges;
+
+	// Neighboring Site Indices of Each Site
+	TArray<TArray<int32>> SiteNeighbors;
+};
+
+/**
+ * Progress & Cancellation Shared Between the Game Thread and a Generation Task
+ */
+struct VORONOIMAP_API FMapGenerationTask
+{
+	// Stage Currently Being Processed
+	std::atomic<EMapGenerationStage> Stage{EMapGenerationStage::Points};
+
+	// Set From the Game Thread to Stop the Task at the Next Checkpoint
+	std::atomic<bool> bCancelRequested{false};
+
+	// Parameters the Task Was Started With
+	FMapGraphSettings Settings;
+
+	// Graph Data Produced by the Task
+	FMapGraphData Graph;
+
+	void SetStage(const EMapGenerationStage NewStage) { Stage = NewStage; }
+	bool IsCancelled() const { return bCancelRequested; }
+
+	// Normalized Progress Through the Whole Pipeline
+	static float GetStageProgress(EMapGenerationStage Stage);
+};
+
+/**
+ * Builds Voronoi Graph Data Without Touching Any UObjects
+ */
+class VORONOIMAP_API FMapGraphBuilder
+{
+public:
+	static bool Build(const FMapGraphSettings& Settings, FMapGraphData& OutGraph, FMapGenerationTask* Task = nullptr);
+
+	static bool BuildChunk(const FMapGraphSettings& Settings, const FIntPoint& Chunk, FMapGraphData& OutGraph);
+
+	static TArray<FVector2D> GeneratePoints(const FMapGraphSettings& Settings);
+
+	static TArray<FVector2D> GenerateChunkPoints(const FMapGraphSettings& Settings, const FIntPoint& Chunk);
+
+	static void KeepLeadingSites(FMapGraphData& Graph, int32 NumKept);
+
+	static void RelateGraph(const FMapGraphSettings& Settings, const FDelaunayMesh& Delaunator, const TArray<FVector2D>& Points, FMapGraphData& OutGraph);
+
+	static EParallelForFlags GetParallelFlags(bool bParallel);
+};
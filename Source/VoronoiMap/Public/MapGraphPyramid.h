@@ -0,0 +1,83 @@
+/**
+ * Coarser Voronoi Graphs Built on Top of the Full Resolution Map
+ * @author Devin DeMatto
+ * @file MapGraphPyramid.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MapGraph.h"
+
+/**
+ * One Resolution of the Pyramid, Level 0 Only Holds Sites of the Full Map
+ */
+struct VORONOIMAP_API FMapGraphLevel
+{
+	// Sites & Voronoi Edges of This Level
+	FMapGraphData Graph;
+
+	// Cell of the Next Coarser Level Each Site Belongs to
+	TArray<int32> Parents;
+
+	// Sites of the Next Finer Level Belonging to Each Cell
+	TArray<TArray<int32>> Children;
+
+	// Closed Cell Outlines, Cell i Uses CellVertices[CellVertexOffsets[i] .. CellVertexOffsets[i + 1])
+	TArray<FVector2D> CellVertices;
+	TArray<int32> CellVertexOffsets;
+
+	// Color of Each Cell, Averaged From its Children
+	TArray<FLinearColor> Colors;
+
+	// One Site Per Grid Cell, Used to Find the Cell Containing a Point
+	TMap<FIntPoint, int32> SiteGrid;
+	float GridCellSize = 0.0f;
+
+	int32 Num() const { return Graph.Sites.Num(); }
+
+	// Vertices of a Cell Clipped to the Pyramid's Bounds, Empty for Cells Entirely Outside Them
+	TArrayView<const FVector2D> GetCellVertices(const int32 Cell) const
+	{
+		return TArrayView<const FVector2D>(CellVertices.GetData() + CellVertexOffsets[Cell], CellVertexOffsets[Cell + 1] - CellVertexOffsets[Cell]);
+	}
+};
+
+/**
+ * LOD Pyramid of Voronoi Graphs, Each Level Subsampled From the One Below
+ */
+class VORONOIMAP_API FMapGraphPyramid
+{
+public:
+	// Every Level Keeps Roughly 1 / (Reduction * Reduction) of the Sites Below it
+	int32 Reduction = 3;
+
+	// Stop Adding Levels Once a Level Has This Few Sites
+	int32 MinSites = 2000;
+
+	// Upper Bound on Levels, Including the Full Resolution One
+	int32 MaxLevels = 6;
+
+	void Build(const TArray<FVector2D>& Sites, float Spacing, bool bParallel, const FBox2D& ClipBounds);
+
+	void UpdateColors(const TArray<FLinearColor>& SiteColors);
+
+	void Reset() { Levels.Reset(); }
+
+	int32 NumLevels() const { return Levels.Num(); }
+
+	const FMapGraphLevel& GetLevel(const int32 Level) const { return Levels[Level]; }
+
+	int32 GetLevelForCellSize(float MinCellSize) const;
+
+private:
+	TArray<FMapGraphLevel> Levels;
+
+	static TArray<int32> SubsampleSites(const TArray<FVector2D>& Sites, float CellSize);
+
+	static void BuildSiteGrid(FMapGraphLevel& Level, float CellSize);
+
+	static int32 FindNearestInGrid(const FMapGraphLevel& Level, const FVector2D& Point);
+
+	static void BuildCellOutlines(FMapGraphLevel& Level, const FBox2D& ClipBounds);
+};
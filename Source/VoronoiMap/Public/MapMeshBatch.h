@@ -0,0 +1,146 @@
+/**
+ * Many Map Polygons Submitted as One Slate Draw Element
+ * @author Devin DeMatto
+ * @file MapMeshBatch.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Rendering/RenderingCommon.h"
+
+class FSlateWindowElementList;
+
+/**
+ * Combined Vertex & Index Buffer in Map Space, Each Polygon Carries its Color on its Vertices
+ */
+class VORONOIMAP_API FMapMeshBatch
+{
+public:
+	void Reset();
+
+	void Reserve(int32 NumVertices, int32 NumIndices);
+
+	void AddPolygon(TArrayView<const FVector2D> PolygonVertices, TArrayView<const SlateIndex> PolygonIndices, const FColor& Color);
+
+	bool IsEmpty() const { return Indices.IsEmpty(); }
+
+	// Drops the Transformed Vertices, Required After Changing the Batch
+	void Invalidate() { bSlateVerticesValid = false; }
+
+	void Paint(FSlateWindowElementList& OutDrawElements, int32 LayerId, const FSlateRenderTransform& MapToRender) const;
+
+private:
+	// Vertex Positions in Map Space
+	TArray<FVector2f> Positions;
+
+	// Color of Each Vertex
+	TArray<FColor> Colors;
+
+	// Triangles Into Positions, Polygon Indices are Offset by Where its Vertices Start
+	TArray<SlateIndex> Indices;
+
+	// Transformed Vertices Handed to Slate, Only Rebuilt When the Batch or its Transform Changes
+	// Slate still copies them into the element list on every paint, so a paint costs O(vertices) either way
+	mutable TArray<FSlateVertex> SlateVertices;
+
+	// Transform SlateVertices Were Built With
+	mutable FSlateRenderTransform SlateVerticesTransform;
+
+	mutable bool bSlateVerticesValid = false;
+};
+
+/**
+ * Polylines in Map Space, Expanded Into Quads of a Fixed On-Screen Thickness & Submitted as One Draw Element
+ * Lines of any color share the batch, each vertex carries its line's color
+ */
+class VORONOIMAP_API FMapLineBatch
+{
+public:
+	void Reset();
+
+	void AddLine(TArrayView<const FVector2D> LinePoints, const FColor& Color);
+
+	bool IsEmpty() const { return LineColors.IsEmpty(); }
+
+	void Invalidate() { bSlateVerticesValid = false; }
+
+	void Paint(FSlateWindowElementList& OutDrawElements, int32 LayerId, const FSlateRenderTransform& MapToRender, float Thickness) const;
+
+private:
+	// Points of Every Line in Map Space
+	TArray<FVector2f> Points;
+
+	// Line i Uses Points[LineStarts[i] .. LineStarts[i + 1])
+	TArray<int32> LineStarts = { 0 };
+
+	TArray<FColor> LineColors;
+
+	// Quads Handed to Slate, Only Rebuilt When the Batch, its Transform or Thickness Changes, Still Copied Each Paint
+	mutable TArray<FSlateVertex> SlateVertices;
+	mutable TArray<SlateIndex> SlateIndices;
+	mutable FSlateRenderTransform SlateVerticesTransform;
+	mutable float SlateVerticesThickness = 0.0f;
+	mutable bool bSlateVerticesValid = false;
+};
+
+/**
+ * Square Markers Centered on Map Space Points, Each With a Fixed On-Screen Size
+ * Every marker becomes one quad of a single draw element, in place of a box element per marker
+ */
+class VORONOIMAP_API FMapPointBatch
+{
+public:
+	void Reset();
+
+	void Reserve(int32 NumPoints);
+
+	void AddPoint(const FVector2D& Point, const FColor& Color, const FVector2D& Size);
+
+	bool IsEmpty() const { return Points.IsEmpty(); }
+
+	void Invalidate() { bSlateVerticesValid = false; }
+
+	void Paint(FSlateWindowElementList& OutDrawElements, int32 LayerId, const FSlateRenderTransform& MapToRender, float Scale) const;
+
+private:
+	// Marker Centers in Map Space
+	TArray<FVector2f> Points;
+
+	// Half Extents of Each Marker Before Scaling
+	TArray<FVector2f> HalfSizes;
+
+	TArray<FColor> Colors;
+
+	// Quads Handed to Slate, Only Rebuilt When the Batch, its Transform or Scale Changes, Still Copied Each Paint
+	mutable TArray<FSlateVertex> SlateVertices;
+	mutable TArray<SlateIndex> SlateIndices;
+	mutable FSlateRenderTransform SlateVerticesTransform;
+	mutable float SlateVerticesScale = 0.0f;
+	mutable bool bSlateVerticesValid = false;
+};
+
+/**
+ * Square Region of the Map With its Own Batch, Tiles Outside the View are Skipped Whole
+ */
+struct VORONOIMAP_API FMapMeshTile
+{
+	// Fill of Every Cell in the Tile, Each Edge Tessellated for the Zoom Band it Was Built at
+	FMapMeshBatch Fill;
+
+	// Visible Edges Owned by the Tile's Cells, Tessellated Like the Fill
+	FMapLineBatch Lines;
+
+	// Zoom Bands Fill & Lines Were Built at, MIN_int32 Until They're Needed
+	int32 FillBand = MIN_int32;
+	int32 LinesBand = MIN_int32;
+
+	// Centroid Markers of the Tile's Cells
+	FMapPointBatch Centroids;
+
+	// Union of the Cells' Bounds, Cells Reach Past the Tile's Square
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	// Cells Whose Centroid Lies in the Tile
+	TArray<int32> Cells;
+};
@@ -5,20 +5,23 @@
 
 #pragma once
 
-#include "Blueprint/UserWidget.h"
 #include "CoreMinimal.h"
+#include "UObject/Object.h"
 #include "Biomes.h"
+#include "Rendering/RenderingCommon.h"
+#include "Templates/Function.h"
 #include "MapNode.generated.h"
 
 enum class EBiomeType : uint8;
 class UMapGeneration;
 class UNodeEdge;
+struct FPaintContext;
 
 /**
  * Base Class for Voronoi Node
  */
 UCLASS()
-class VORONOIMAP_API UMapNode : public UUserWidget
+class VORONOIMAP_API UMapNode : public UObject
 {
 	GENERATED_BODY()
 
@@ -45,10 +48,19 @@ private:
 	// Height of Node
 	float Height = 0.0f;
 
-	// Vertices for Mesh Generation
-	TArray<FVector2D> Vertices;
+	// Edges Whose Curve Runs Against Circulation Order, Aligned With Edges
+	TBitArray<> ReversedEdges;
 
-	// Indices for Mesh Generation
+	// Points Along the Outline, Summed Over Every Edge's Curve
+	int32 NumOutlinePoints = 0;
+
+	// Box Around the Outline, Used to Skip Nodes Outside the View
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	// Mesh Vertices Start With the Centroid as Fan Hub, Followed by the Outline
+	bool bHasFanHub = false;
+
+	// Indices for Mesh Generation, Into the Hub & Outline
 	TArray<SlateIndex> Indices;
 
 	// Color of 2D Polygon
@@ -60,13 +72,15 @@ private:
 	// Draw Vertices Traversal (DEBUG)
 	bool bDrawVerticesTraversal = false;
 
+	// Flagged to be Compacted Out of the Graph
+	bool bMarkedForRemoval = false;
+
 	// Default constructor
-	explicit UMapNode(const FObjectInitializer& ObjectInitializer) : UUserWidget(ObjectInitializer) {}
+	explicit UMapNode(const FObjectInitializer& ObjectInitializer) : UObject(ObjectInitializer) {}
 
-	void SortEdges();
+	bool IsStarShaped() const;
 
-	// Node Positioning Check
-	bool IsInNode(const FVector2D& Point);
+	void TriangulateOutline();
 
 public:
 	///////////////////////////
@@ -76,7 +90,13 @@ public:
 	void SetupNode(UMapGeneration*, FVector2D);
 	void AddNeighbor(UMapNode*);
 	void AddEdge(UNodeEdge*);
-	void BuildMesh();
+	bool BuildMesh();
+
+	// Node Positioning Check, Against the Curved Outline
+	bool IsInNode(const FVector2D& Point) const;
+
+	void MarkForRemoval() { bMarkedForRemoval = true; }
+	bool IsMarkedForRemoval() const { return bMarkedForRemoval; }
 
 	/////////////////////
 	/// Node Selection //
@@ -105,15 +125,51 @@ public:
 	UFUNCTION(BlueprintPure, Category = "Node Data")
 	FVector2D GetCentroid() const;
 
+	FColor GetColor() const { return Color; }
+	FLinearColor GetCentroidColor() const { return CentroidColor; }
+
+	// Debug Traversal Points are Drawn Over the Selected Node
+	void SetDrawVerticesTraversal(bool bInDrawVerticesTraversal);
+
+	// Walks the Cell Boundary Through the Map's Shared Curve Buffer, Edge by Edge in Circulation Order
+	// EdgeLODs Holds a Curve LOD Per Edge, Aligned With Edges, Empty Walks Every Curve at Full Detail
+	void ForEachOutlinePoint(TFunctionRef<void(const FVector2D&)> Visitor, TConstArrayView<int32> EdgeLODs = {}) const;
+
+	int32 GetNumOutlinePoints() const { return NumOutlinePoints; }
+
+	int32 GetNumOutlinePoints(TConstArrayView<int32> EdgeLODs) const;
+
+	// Fans Can be Rebuilt Over a Coarser Outline, Ear Clipped Cells Only Have a Mesh for the Full One
+	bool SupportsCurveLOD() const { return bHasFanHub; }
+
+	const FBox2D& GetBounds() const { return Bounds; }
+
+	// Copy of the Cell Boundary
+	TArray<FVector2D> GetOutline() const;
+
+	// Vertices the Mesh Indices Refer to, Hub First if the Cell is a Fan
+	template <typename AllocatorType>
+	void GetMeshVertices(TArray<FVector2D, AllocatorType>& OutVertices, const TConstArrayView<int32> EdgeLODs = {}) const
+	{
+		OutVertices.Reset(GetNumOutlinePoints(EdgeLODs) + 1);
+		if (bHasFanHub)
+		{
+			OutVertices.Add(Centroid);
+		}
+		ForEachOutlinePoint([&OutVertices](const FVector2D& Point) { OutVertices.Add(Point); }, EdgeLODs);
+	}
+
+	const TArray<SlateIndex>& GetIndices() const { return Indices; }
+
+	static const TArray<SlateIndex>& GetFanIndices();
+
+	// Triangles From the Hub Around a Closed Outline, Appended to OutIndices
+	static void AppendFanIndices(int32 NumOutline, TArray<SlateIndex>& OutIndices);
+
 	//////////////////
 	//  Event Logic //
 	//////////////////
 
-	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
-							  FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
-							  bool bParentEnabled) const override;
-
-	virtual FReply NativeOnMouseMove(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
-	virtual FReply NativeOnMouseButtonDown(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
-	virtual FReply NativeOnMouseButtonUp(const FGeometry& InGeometry, const FPointerEvent& InMouseEvent) override;
+	// Debug Overlays Drawn by the Map View Over the Batched Fill, OverlayContext Paints on the Map's Overlay Layer
+	void PaintOverlay(const FPaintContext& OverlayContext) const;
 };
@@ -0,0 +1,78 @@
+/**
+ * CPU Rasterizer for Drawing the Whole Map Into a Texture
+ * @author Devin DeMatto
+ * @file MapRaster.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Triangles & Lines Copied Off the Map, so the Pixels Can be Drawn Away From the Game Thread
+ */
+struct VORONOIMAP_API FMapRasterShapes
+{
+	// Three Corners Per Triangle
+	TArray<FVector2D> TriangleCorners;
+
+	// One Per Triangle
+	TArray<FColor> TriangleColors;
+
+	// Every Line's Points Back to Back
+	TArray<FVector2D> LinePoints;
+
+	// Where Each Line Ends in LinePoints
+	TArray<int32> LineEnds;
+
+	// One Per Line
+	TArray<FColor> LineColors;
+
+	void AddTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FColor& Color);
+
+	void AddLine(TArrayView<const FVector2D> Points, const FColor& Color);
+};
+
+/**
+ * Pixel Buffer Covering a Box of Map Space, Row 0 is the Box's Minimum Y Like Widget Space
+ * Filled once when the map changes, so plain scanning over each shape's bounds is enough
+ */
+class VORONOIMAP_API FMapRaster
+{
+public:
+	void Reset(const FBox2D& InBounds, const FIntPoint& InSize, const FColor& ClearColor);
+
+	void FillTriangle(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FColor& Color);
+
+	void DrawLine(TArrayView<const FVector2D> Points, const FColor& Color);
+
+	void DrawShapes(const FMapRasterShapes& Shapes);
+
+	FColor GetPixel(const FIntPoint& Pixel) const { return Pixels[Pixel.Y * Size.X + Pixel.X]; }
+
+	const TArray<FColor>& GetPixels() const { return Pixels; }
+
+	const FIntPoint& GetSize() const { return Size; }
+
+	const FBox2D& GetBounds() const { return Bounds; }
+
+private:
+	// Row Major, Size.X Pixels Per Row
+	TArray<FColor> Pixels;
+
+	FIntPoint Size = FIntPoint::ZeroValue;
+
+	// Map Space Box the Pixels Cover
+	FBox2D Bounds = FBox2D(ForceInit);
+
+	// Line Each Pixel Was Last Blended by, so a Line Never Blends the Same Pixel Twice
+	TArray<uint32> LineStamps;
+	uint32 LineStamp = 0;
+
+	// Pixels Per Map Unit Along Each Axis
+	FVector2D Scale = FVector2D::ZeroVector;
+
+	FVector2D ToPixelSpace(const FVector2D& Point) const { return (Point - Bounds.Min) * Scale; }
+
+	void BlendPixel(int32 X, int32 Y, const FColor& Color);
+};
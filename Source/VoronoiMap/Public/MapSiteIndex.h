@@ -0,0 +1,50 @@
+/**
+ * Uniform Grid Over the Sites of the Map, Used to Find the Cell Under a Point
+ * @author Devin DeMatto
+ * @file MapSiteIndex.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Buckets Sites by Grid Cell, Sites of Cell i are CellSites[CellStarts[i] .. CellStarts[i + 1])
+ * Poisson sampled sites sit about one per Spacing, so a Spacing sized grid holds a handful of sites per cell
+ */
+class VORONOIMAP_API FMapSiteIndex
+{
+public:
+	void Build(const TArray<FVector2D>& InSites, float InCellSize);
+
+	void Reset();
+
+	bool IsEmpty() const { return Sites.IsEmpty(); }
+
+	int32 FindNearest(const FVector2D& Point) const;
+
+	void FindKNearest(const FVector2D& Point, int32 Count, TArray<int32>& OutSites) const;
+
+private:
+	// Site Positions, Indexed Like the Map's Nodes
+	TArray<FVector2D> Sites;
+
+	// Offsets Into CellSites, One Past the Last Cell Included
+	TArray<int32> CellStarts;
+
+	// Site Indices Sorted by Grid Cell
+	TArray<int32> CellSites;
+
+	// Bottom Left Corner of the Grid in Map Space
+	FVector2D Origin = FVector2D::ZeroVector;
+
+	// Number of Cells Along Each Axis
+	FIntPoint Dimensions = FIntPoint::ZeroValue;
+
+	float CellSize = 0.0f;
+
+	FIntPoint GetCell(const FVector2D& Point) const;
+
+	template <typename VisitorType, typename BoundType>
+	void SearchRings(const FVector2D& Point, VisitorType&& VisitSite, BoundType&& GetBoundSquared) const;
+};
@@ -6,11 +6,12 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "Blueprint/UserWidget.h"
+#include "UObject/Object.h"
 #include "NodeEdge.generated.h"
 
 class UMapGeneration;
 class UMapNode;
+struct FMapGraphEdge;
 
 
 UENUM(BlueprintType)
@@ -34,7 +35,7 @@ enum class ESelectionState : uint8
  * Base Class for Edge of Voronoi Node
  */
 UCLASS()
-class VORONOIMAP_API UNodeEdge : public UUserWidget
+class VORONOIMAP_API UNodeEdge : public UObject
 {
 	GENERATED_BODY()
 public:
@@ -48,18 +49,18 @@ public:
 	UPROPERTY()
 	ESelectionState SelectionState = ESelectionState::Default;
 
-	/// Nodes that are related to this edge
-	UPROPERTY()
-	TArray<UMapNode*> Nodes;
+	/// Slot of This Edge in the Map's Edge Table, Which Holds the Nodes it Separates
+	int32 Index = INDEX_NONE;
 
-	// Circumcenter A
-	FVector2D PointA;
+	// Circumcenter A, Index Into the Map's Vertex Pool
+	int32 VertexA = INDEX_NONE;
 
-	// Circumcenter B
-	FVector2D PointB;
+	// Circumcenter B, Index Into the Map's Vertex Pool
+	int32 VertexB = INDEX_NONE;
 
-	// Points Making up BezierCurve
-	TArray<FVector2D> BezierCurvePoints;
+	// Range of the Map's Curve Buffer Making up the BezierCurve, Runs From VertexA to VertexB
+	int32 CurveStart = 0;
+	int32 CurveNum = 0;
 
 	// Flag if Edge is Inside Map
 	bool bIsEdgeInsideMap;
@@ -67,22 +68,52 @@ public:
 	// Flag if Edge is Partially In Map
 	bool bIsPartiallyInMap;
 
+	// Neighboring Chunk Draws Its Own Copy of This Seam Edge
+	bool bIsSeamCopy = false;
+
 	// Color Of Edge
 	FLinearColor Color;
 
-	bool bDrawA = false;
-	bool bDrawB = false;
-
 	// Constructor & Initial Setup
-	explicit UNodeEdge(const FObjectInitializer& ObjectInitializer) : UUserWidget(ObjectInitializer) {}
+	explicit UNodeEdge(const FObjectInitializer& ObjectInitializer) : UObject(ObjectInitializer) {}
+
+	void SetupEdge(const FMapGraphEdge& GraphEdge, int32 VertexOffset, UMapGeneration* InMapGenerator);
+
+	const FVector2D& GetPointA() const;
+	const FVector2D& GetPointB() const;
+
+	// Node in Slot 0 or 1 of the Edge Table, Null for an Empty Slot
+	UMapNode* GetNode(int32 Slot) const;
 
-	void SetupEdge(const FVector2D& InPointA, const FVector2D& InPointB, UMapGeneration* InMapGenerator);
+	// Bezier Calculation
 
-	// Edge Positioning & Bezier Calculation
+	// Points Evaluated Along Every Curve, 2^k + 1 so Every Coarser LOD Splits the Curve Evenly
+	static constexpr int32 NumBezierPoints = 25;
 
-	bool IsPointInsideMap(const FVector2D& Point) const;
+	TArrayView<const FVector2D> GetCurvePoints() const;
 
-	void CalculateBezier();
+	// Coarser Tessellations Keep Every 2^LOD-th Point of the Curve, the Coarsest is the Straight Chord
+	static constexpr int32 NumCurveLODs = 5;
+
+	static int32 GetNumCurvePoints(int32 LOD);
+
+	// Index Into the Full Curve of a Coarser Tessellation's Point, Endpoints are Kept at Every LOD
+	static int32 GetCurvePointIndex(int32 LOD, int32 Index);
+
+	template <typename AllocatorType>
+	void GetCurvePoints(const int32 LOD, TArray<FVector2D, AllocatorType>& OutPoints) const
+	{
+		const TArrayView<const FVector2D> Curve = GetCurvePoints();
+		const int32 NumPoints = GetNumCurvePoints(LOD);
+
+		OutPoints.Reset(NumPoints);
+		for (int32 Index = 0; Index < NumPoints; ++Index)
+		{
+			OutPoints.Add(Curve[GetCurvePointIndex(LOD, Index)]);
+		}
+	}
+
+	static void EvaluateBezier(const FVector2D& InPointA, const FVector2D& InPointB, TArrayView<FVector2D> OutPoints);
 
 	////////////////////
 	// Edge Selection //
@@ -96,11 +127,6 @@ public:
 
 	void UpdateEdgeColor();
 
-	//////////////////
-	//  Event Logic //
-	//////////////////
-
-	virtual int32 NativePaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
-							  FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
-							  bool bParentEnabled) const override;
+	// Color of the Edge's Type Regardless of Selection, What the Map's Raster Cache Draws
+	FLinearColor GetTypeColor() const;
 };
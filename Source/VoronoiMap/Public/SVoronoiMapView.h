@@ -0,0 +1,37 @@
+/**
+ * Slate Widget Drawing the Map's Cells, Edges & Overlays
+ * @author Devin DeMatto
+ * @file SVoronoiMapView.h
+ */
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Widgets/SLeafWidget.h"
+
+class UMapGeneration;
+
+/**
+ * Paints & Culls the Whole Map From the Generator's Batches, Nodes & Edges are Plain Data to it
+ * Sits beneath the map widget's own content & never takes input, the map widget selects nodes so clicks
+ * reach it whatever its Blueprint content does with them
+ */
+class VORONOIMAP_API SVoronoiMapView : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SVoronoiMapView) {}
+		// Generator Owning the Map Data & View Transform
+		SLATE_ARGUMENT(UMapGeneration*, Map)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs);
+
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle, bool bParentEnabled) const override;
+
+protected:
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	TWeakObjectPtr<UMapGeneration> Map;
+};
@@ -108,4 +108,23 @@ public:
 
 	EBiomeType DetermineBiome(const UMapNode* Node, float Moisture) const;
 	void GenerateCliffs();
+
+	// Terrain for Nodes Appended Since FirstNode, Resident Nodes Keep Theirs
+	void GenerateChunkTerrain(int32 FirstNode);
+
+	// Drops Cached Nodes & Edges That Went Back to the Pools
+	void ReleaseRemoved();
+
+	//////////////////////
+	// Parameter Hashes //
+	//////////////////////
+
+	uint32 GetLandParameterHash() const;
+	uint32 GetCliffParameterHash() const;
+	uint32 GetBiomeParameterHash() const;
+
+private:
+	void GenerateLandFrom(int32 FirstNode);
+	void GenerateCliffsFrom(int32 FirstNode);
+	void GenerateBiomesFrom(int32 FirstLandNode);
 };
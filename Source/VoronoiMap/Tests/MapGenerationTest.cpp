@@ -1,20 +1,743 @@
 #include "MapGeneration.h"
+#include "MapGraph.h"
+#include "MapGraphPyramid.h"
+#include "MapRaster.h"
 #include "DelaunayHelper.h"
 #include "Misc/AutomationTest.h"
 #include "MapNode.h"
 #include "NodeEdge.h"
+#include "TerrainGenerator.h"
 
 
 BEGIN_DEFINE_SPEC(FMapGenerationTests, "MapGenerationTests", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter)
 
+	// Map With One Cell Whose Edges Run Straight Around Outline
+	UMapNode* MakeSingleCell(const TArray<FVector2D>& Outline, const FVector2D& Site) const;
+
+	// Total Area of the Triangles in a Cell's Mesh
+	static double GetMeshArea(const UMapNode* Node);
+
 END_DEFINE_SPEC(FMapGenerationTests)
 
 
+UMapNode* FMapGenerationTests::MakeSingleCell(const TArray<FVector2D>& Outline, const FVector2D& Site) const
+{
+	UMapGeneration* MapGen = NewObject<UMapGeneration>();
+	const FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+
+	FMapGraphData Graph;
+	Graph.Sites.Add(Site);
+	Graph.Vertices = Outline;
+	Graph.SiteEdges.AddDefaulted();
+	Graph.SiteNeighbors.AddDefaulted();
+
+	for (int32 Index = 0; Index < Outline.Num(); ++Index)
+	{
+		FMapGraphEdge& Edge = Graph.Edges.AddDefaulted_GetRef();
+		Edge.VertexA = Index;
+		Edge.VertexB = (Index + 1) % Outline.Num();
+		Edge.NodeA = 0;
+		Edge.CurveStart = Graph.CurvePoints.Num();
+		Edge.CurveNum = 2;
+		Edge.bIsEdgeInsideMap = true;
+
+		Graph.CurvePoints.Add(Outline[Edge.VertexA]);
+		Graph.CurvePoints.Add(Outline[Edge.VertexB]);
+		Graph.SiteEdges[0].Add(Index);
+	}
+
+	MapGen->ApplyGraph(Settings, Graph);
+	return MapGen->GetNodes().Num() == 1 ? MapGen->GetNodes()[0] : nullptr;
+}
+
+double FMapGenerationTests::GetMeshArea(const UMapNode* Node)
+{
+	TArray<FVector2D> MeshVertices;
+	Node->GetMeshVertices(MeshVertices);
+
+	double Area = 0.0;
+	const TArray<SlateIndex>& Indices = Node->GetIndices();
+	for (int32 Index = 0; Index + 2 < Indices.Num(); Index += 3)
+	{
+		const FVector2D& A = MeshVertices[Indices[Index]];
+		const FVector2D& B = MeshVertices[Indices[Index + 1]];
+		const FVector2D& C = MeshVertices[Indices[Index + 2]];
+		Area += FMath::Abs(FVector2D::CrossProduct(B - A, C - A)) / 2;
+	}
+	return Area;
+}
+
+
 void FMapGenerationTests::Define()
 {
 	Describe("Graph Creation and Transformation", [this]()
 	{
+		It("should relate every edge to the two sites it separates", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.MapSize = FVector2D(500, 500);
+			Settings.BoundaryOffset = FVector2D(150, 150);
+			Settings.Seed = 1337;
+
+			// Act
+			FMapGraphData Graph;
+			const bool bCompleted = FMapGraphBuilder::Build(Settings, Graph);
+
+			// Assert
+			TestTrue(TEXT("Graph should build without a task"), bCompleted);
+			TestTrue(TEXT("Graph should contain edges"), Graph.Edges.Num() > 0);
+
+			for (int32 EdgeIndex = 0; EdgeIndex < Graph.Edges.Num(); ++EdgeIndex)
+			{
+				const FMapGraphEdge& Edge = Graph.Edges[EdgeIndex];
+				if (!TestTrue(TEXT("Edge should reference valid sites"), Graph.Sites.IsValidIndex(Edge.NodeA) && Graph.Sites.IsValidIndex(Edge.NodeB)))
+				{
+					return;
+				}
+
+				TestTrue(TEXT("Site A should list the edge"), Graph.SiteEdges[Edge.NodeA].Contains(EdgeIndex));
+				TestTrue(TEXT("Site B should list the edge"), Graph.SiteEdges[Edge.NodeB].Contains(EdgeIndex));
+				TestTrue(TEXT("Sites on an edge should be neighbors"), Graph.SiteNeighbors[Edge.NodeA].Contains(Edge.NodeB));
+				TestTrue(TEXT("Edge should reference pooled vertices"), Graph.Vertices.IsValidIndex(Edge.VertexA) && Graph.Vertices.IsValidIndex(Edge.VertexB));
+			}
+		});
+
+		It("should list each site's edges as a connected ring", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.MapSize = FVector2D(500, 500);
+			Settings.BoundaryOffset = FVector2D(150, 150);
+			Settings.Seed = 1337;
+
+			// Act
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+
+			// Assert
+			for (int32 Site = 0; Site < Graph.Sites.Num(); ++Site)
+			{
+				const TArray<int32>& SiteEdges = Graph.SiteEdges[Site];
+
+				// Hull sites are open & always clipped away
+				if (SiteEdges.Num() != Graph.SiteNeighbors[Site].Num())
+				{
+					continue;
+				}
+
+				for (int32 Index = 0; Index < SiteEdges.Num(); ++Index)
+				{
+					const FMapGraphEdge& Edge = Graph.Edges[SiteEdges[Index]];
+					const FMapGraphEdge& NextEdge = Graph.Edges[SiteEdges[(Index + 1) % SiteEdges.Num()]];
+
+					const bool bSharesVertex = Edge.VertexA == NextEdge.VertexA || Edge.VertexA == NextEdge.VertexB ||
+						Edge.VertexB == NextEdge.VertexA || Edge.VertexB == NextEdge.VertexB;
+					TestTrue(TEXT("Consecutive edges should share a vertex"), bSharesVertex);
+				}
+			}
+		});
+
+		It("should stop building when the task is cancelled", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.MapSize = FVector2D(500, 500);
+
+			FMapGenerationTask Task;
+			Task.bCancelRequested = true;
+
+			// Act
+			const bool bCompleted = FMapGraphBuilder::Build(Settings, Task.Graph, &Task);
+
+			// Assert
+			TestFalse(TEXT("Cancelled task should not complete"), bCompleted);
+			TestTrue(TEXT("Cancelled task should not relate the graph"), Task.Graph.Edges.IsEmpty());
+		});
+
+		It("should generate a map without the widget being constructed", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.Seed = 1337;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+
+			// Act
+			MapGen->ApplyGraph(Settings, Graph);
+
+			// Assert
+			TestNotNull(TEXT("Terrain generator should be created on demand"), MapGen->TerrainGen);
+			TestTrue(TEXT("Map should contain nodes"), MapGen->GetNodes().Num() > 0);
+
+			for (const UNodeEdge* Edge : MapGen->GetEdges())
+			{
+				const bool bIsAInside = Settings.IsPointInsideMap(Edge->GetPointA());
+				const bool bIsBInside = Settings.IsPointInsideMap(Edge->GetPointB());
+				TestEqual(TEXT("Edge bounds should come from the settings"), Edge->bIsEdgeInsideMap, bIsAInside && bIsBInside);
+
+				const TArrayView<const FVector2D> Curve = Edge->GetCurvePoints();
+				TestTrue(TEXT("Edge curve should start at its first vertex"), Curve.Num() > 1 && Curve[0].Equals(Edge->GetPointA(), 1e-3));
+				TestTrue(TEXT("Edge curve should end at its second vertex"), Curve.Num() > 1 && Curve.Last().Equals(Edge->GetPointB(), 1e-3));
+
+				TArray<FVector2D> CoarseCurve;
+				for (int32 LOD = 1; LOD < UNodeEdge::NumCurveLODs; ++LOD)
+				{
+					Edge->GetCurvePoints(LOD, CoarseCurve);
+					TestTrue(TEXT("Coarser curves should have fewer points"), CoarseCurve.Num() < Curve.Num());
+					TestTrue(TEXT("Coarser curves should keep both vertices"), CoarseCurve[0] == Curve[0] && CoarseCurve.Last() == Curve.Last());
+				}
+			}
+
+			for (int32 EdgeIndex = 0; EdgeIndex < MapGen->GetEdges().Num(); ++EdgeIndex)
+			{
+				const UNodeEdge* Edge = MapGen->GetEdges()[EdgeIndex];
+				TestEqual(TEXT("Edge should know its slot in the edge table"), Edge->Index, EdgeIndex);
+				TestTrue(TEXT("Compacted edges should keep at least one node"), Edge->GetNode(0) != nullptr);
+				TestTrue(TEXT("Edge nodes should list the edge"), Edge->GetNode(0)->Edges.Contains(Edge));
+			}
+		});
+
+		It("should split every curve into even segments at each LOD", [this]()
+		{
+			for (int32 LOD = 0; LOD < UNodeEdge::NumCurveLODs; ++LOD)
+			{
+				// Arrange
+				const int32 NumPoints = UNodeEdge::GetNumCurvePoints(LOD);
+				const int32 Stride = UNodeEdge::GetCurvePointIndex(LOD, 1);
+
+				// Act & Assert
+				TestEqual(TEXT("Every LOD should end on the curve's last point"), UNodeEdge::GetCurvePointIndex(LOD, NumPoints - 1), UNodeEdge::NumBezierPoints - 1);
+				for (int32 Index = 1; Index < NumPoints; ++Index)
+				{
+					const int32 Step = UNodeEdge::GetCurvePointIndex(LOD, Index) - UNodeEdge::GetCurvePointIndex(LOD, Index - 1);
+					TestEqual(TEXT("Segments of an LOD should span the same number of points"), Step, Stride);
+				}
+			}
+		});
+
+		It("should build identical edges on both sides of a chunk border", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.bChunked = true;
+			Settings.ChunkSize = FVector2D(500, 500);
+			Settings.Seed = 1337;
+
+			// Act
+			FMapGraphData Left;
+			FMapGraphData Right;
+			FMapGraphBuilder::BuildChunk(Settings, FIntPoint(0, 0), Left);
+			FMapGraphBuilder::BuildChunk(Settings, FIntPoint(1, 0), Right);
+
+			// Assert
+			int32 NumSeamEdges = 0;
+			for (const FMapGraphEdge& Edge : Left.Edges)
+			{
+				// Seam edges away from the corners can only border the chunk to the right
+				const FVector2D& PointA = Left.Vertices[Edge.VertexA];
+				const FVector2D& PointB = Left.Vertices[Edge.VertexB];
+				const FVector2D MidPoint = (PointA + PointB) / 2;
+				const bool bIsSeamEdge = Edge.NodeA == INDEX_NONE || Edge.NodeB == INDEX_NONE;
+				if (!bIsSeamEdge || MidPoint.X < 250 || MidPoint.Y < 100 || MidPoint.Y > 400)
+				{
+					continue;
+				}
+
+				++NumSeamEdges;
+				const FMapGraphEdge* RightEdge = Right.Edges.FindByPredicate([&](const FMapGraphEdge& Other)
+				{
+					return Right.Vertices[Other.VertexA].Equals(PointA, 1e-3) && Right.Vertices[Other.VertexB].Equals(PointB, 1e-3);
+				});
+				if (TestNotNull(TEXT("Seam edge should match the neighboring chunk"), RightEdge))
+				{
+					TestFalse(TEXT("Lower chunk should draw the seam edge"), Edge.bIsSeamCopy);
+					TestTrue(TEXT("Higher chunk should leave the seam edge to its neighbor"), RightEdge->bIsSeamCopy);
+				}
+			}
+
+			TestTrue(TEXT("Chunks should share a border"), NumSeamEdges > 0);
+		});
+
+		It("should drop unloaded chunks from the terrain caches before regenerating cliffs", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+			MapGen->bChunkedWorld = true;
+			MapGen->ChunkLoadRadius = 1;
+			MapGen->GenerateMap();
+
+			// Act
+			MapGen->ChunkLoadRadius = 0;
+			MapGen->UpdateResidentChunks();
+
+			MapGen->TerrainGen->CliffDiff /= 2;
+			MapGen->RegenerateMap();
+
+			// Assert
+			const TArray<UNodeEdge*>& Edges = MapGen->GetEdges();
+			for (const UNodeEdge* Edge : MapGen->TerrainGen->LandEdges)
+			{
+				TestTrue(TEXT("Cached land edges should still be resident"), Edges.IsValidIndex(Edge->Index) && Edges[Edge->Index] == Edge);
+			}
+
+			for (const UMapNode* Node : MapGen->TerrainGen->LandNodes)
+			{
+				TestTrue(TEXT("Cached land nodes should still be resident"), MapGen->GetNodes().Contains(Node));
+			}
+		});
+
+		It("should give loaded chunks the same terrain as a full terrain run", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+			MapGen->bChunkedWorld = true;
+			MapGen->ChunkLoadRadius = 0;
+			MapGen->GenerateMap();
+
+			// Act
+			MapGen->ChunkLoadRadius = 1;
+			MapGen->UpdateResidentChunks();
+
+			const TSet<UMapNode*> ChunkLandNodes(MapGen->TerrainGen->LandNodes);
+			const TSet<UNodeEdge*> ChunkLandEdges(MapGen->TerrainGen->LandEdges);
+			TArray<EEdgeType> ChunkEdgeTypes;
+			for (const UNodeEdge* Edge : MapGen->GetEdges())
+			{
+				ChunkEdgeTypes.Add(Edge->EdgeType);
+			}
+
+			MapGen->TerrainGen->GenerateTerrain();
+
+			// Assert
+			TestEqual(TEXT("Land edges should only be cached once"), ChunkLandEdges.Num(), MapGen->TerrainGen->LandEdges.Num());
+			TestTrue(TEXT("Loaded chunks should cache the same land nodes"), ChunkLandNodes.Difference(TSet<UMapNode*>(MapGen->TerrainGen->LandNodes)).IsEmpty());
+			TestTrue(TEXT("Loaded chunks should cache the same land edges"), ChunkLandEdges.Difference(TSet<UNodeEdge*>(MapGen->TerrainGen->LandEdges)).IsEmpty());
+
+			for (int32 EdgeIndex = 0; EdgeIndex < MapGen->GetEdges().Num(); ++EdgeIndex)
+			{
+				TestTrue(TEXT("Loaded chunks should find the same cliffs"), ChunkEdgeTypes[EdgeIndex] == MapGen->GetEdges()[EdgeIndex]->EdgeType);
+			}
+		});
+
+		It("should find the same node under a point as checking every node", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.Seed = 99;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+			MapGen->ApplyGraph(Settings, Graph);
+
+			FRandomStream RandomStream(42);
+			for (int32 Sample = 0; Sample < 200; ++Sample)
+			{
+				const FVector2D Point(RandomStream.FRandRange(0, Settings.MapSize.X), RandomStream.FRandRange(0, Settings.MapSize.Y));
+
+				// Act
+				const UMapNode* Found = MapGen->FindNodeUnderPoint(Point);
+
+				// Assert
+				const UMapNode* const* Expected = MapGen->GetNodes().FindByPredicate([&Point](const UMapNode* Node) { return Node->IsInNode(Point); });
+				TestEqual(TEXT("Indexed lookup should match checking every node"), Found, Expected ? *Expected : nullptr);
+			}
+		});
+
+		It("should find the nearest nodes like sorting every node by distance", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.Seed = 5;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+			MapGen->ApplyGraph(Settings, Graph);
+
+			FRandomStream RandomStream(42);
+			for (int32 Sample = 0; Sample < 50; ++Sample)
+			{
+				const FVector2D Point(RandomStream.FRandRange(-100, Settings.MapSize.X + 100), RandomStream.FRandRange(-100, Settings.MapSize.Y + 100));
+
+				// Act
+				const UMapNode* Found = MapGen->FindNodeAt(Point);
+				const TArray<UMapNode*> Nearest = MapGen->FindKNearest(Point, 5);
+
+				// Assert
+				TArray<UMapNode*> Expected = MapGen->GetNodes();
+				Expected.Sort([&Point](const UMapNode& A, const UMapNode& B)
+				{
+					return FVector2D::DistSquared(Point, A.GetCentroid()) < FVector2D::DistSquared(Point, B.GetCentroid());
+				});
+
+				TestEqual(TEXT("Node at a point should own the nearest centroid"), Found, Expected[0]);
+				if (TestEqual(TEXT("Should return as many nodes as asked for"), Nearest.Num(), 5))
+				{
+					for (int32 Index = 0; Index < Nearest.Num(); ++Index)
+					{
+						TestEqual(TEXT("Nearest nodes should match in order"), Nearest[Index], Expected[Index]);
+					}
+				}
+			}
+		});
+
+		It("should find the nearest nodes to points far outside the map", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.Seed = 9;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+			MapGen->ApplyGraph(Settings, Graph);
+
+			const FVector2D Center = Settings.MapSize / 2;
+			const TArray<FVector2D> Points = {
+				FVector2D(-5000, -5000), FVector2D(Center.X, -3000), FVector2D(Settings.MapSize.X + 4000, Center.Y),
+				FVector2D(-2000, Settings.MapSize.Y + 7000), FVector2D(Settings.MapSize.X + 50, Settings.MapSize.Y + 50)
+			};
+
+			for (const FVector2D& Point : Points)
+			{
+				// Act
+				const UMapNode* Found = MapGen->FindNodeAt(Point);
+				const TArray<UMapNode*> Nearest = MapGen->FindKNearest(Point, 3);
+
+				// Assert
+				TArray<UMapNode*> Expected = MapGen->GetNodes();
+				Expected.Sort([&Point](const UMapNode& A, const UMapNode& B)
+				{
+					return FVector2D::DistSquared(Point, A.GetCentroid()) < FVector2D::DistSquared(Point, B.GetCentroid());
+				});
+
+				TestEqual(TEXT("Outside point should find the nearest centroid"), Found, Expected[0]);
+				if (TestEqual(TEXT("Should return as many nodes as asked for"), Nearest.Num(), 3))
+				{
+					for (int32 Index = 0; Index < Nearest.Num(); ++Index)
+					{
+						TestEqual(TEXT("Nearest nodes should match in order"), Nearest[Index], Expected[Index]);
+					}
+				}
+			}
+		});
+	});
+
+	Describe("Cell Triangulation", [this]()
+	{
+		It("should fan a star-shaped cell from its centroid", [this]()
+		{
+			// Arrange
+			const TArray<FVector2D> Square = { FVector2D(200, 200), FVector2D(230, 200), FVector2D(230, 230), FVector2D(200, 230) };
+
+			// Act
+			const UMapNode* Node = MakeSingleCell(Square, FVector2D(215, 215));
+
+			// Assert
+			if (!TestNotNull(TEXT("Cell should be built"), Node))
+			{
+				return;
+			}
+
+			TestTrue(TEXT("Star-shaped cell should be a fan"), Node->SupportsCurveLOD());
+			TestEqual(TEXT("Fan should have a triangle per outline point"), Node->GetIndices().Num(), Node->GetNumOutlinePoints() * 3);
+			TestEqual(TEXT("Fan should cover the cell"), GetMeshArea(Node), 900.0, 1e-6);
+		});
+
+		It("should ear clip a concave cell that isn't star-shaped from its centroid", [this]()
+		{
+			// Arrange, a U Whose Notch Hides the Inner Walls From the Site
+			const TArray<FVector2D> UShape = {
+				FVector2D(200, 200), FVector2D(230, 200), FVector2D(230, 230), FVector2D(220, 230),
+				FVector2D(220, 210), FVector2D(210, 210), FVector2D(210, 230), FVector2D(200, 230)
+			};
+
+			// Act
+			const UMapNode* Node = MakeSingleCell(UShape, FVector2D(205, 205));
+
+			// Assert
+			if (!TestNotNull(TEXT("Cell should be built"), Node))
+			{
+				return;
+			}
+
+			TestFalse(TEXT("Cell that isn't star-shaped should not be a fan"), Node->SupportsCurveLOD());
+			TestEqual(TEXT("Ear clipping should cover the cell without overlap"), GetMeshArea(Node), 700.0, 1e-6);
+		});
+
+		It("should only fan cells the shared fan indices can cover", [this]()
+		{
+			// Arrange, Each Straight Edge Adds Two Outline Points
+			const auto MakeCircle = [](const int32 NumVertices)
+			{
+				TArray<FVector2D> Circle;
+				for (int32 Index = 0; Index < NumVertices; ++Index)
+				{
+					const double Angle = UE_DOUBLE_TWO_PI * Index / NumVertices;
+					Circle.Add(FVector2D(250, 250) + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * 100);
+				}
+				return Circle;
+			};
+
+			// Act
+			const UMapNode* AtCap = MakeSingleCell(MakeCircle(512), FVector2D(250, 250));
+			const UMapNode* PastCap = MakeSingleCell(MakeCircle(513), FVector2D(250, 250));
+
+			// Assert
+			TestEqual(TEXT("Fan indices should cover 1024 outline points"), UMapNode::GetFanIndices().Num(), 1023 * 3);
+			if (!TestNotNull(TEXT("Cells should be built"), AtCap) || !TestNotNull(TEXT("Cells should be built"), PastCap))
+			{
+				return;
+			}
+
+			TestEqual(TEXT("Cell at the cap should have 1024 outline points"), AtCap->GetNumOutlinePoints(), 1024);
+			TestTrue(TEXT("Cell at the cap should be a fan"), AtCap->SupportsCurveLOD());
+			TestFalse(TEXT("Cell past the cap should fall back to ear clipping"), PastCap->SupportsCurveLOD());
+			TestEqual(TEXT("Ear clipping should still cover the cell"), GetMeshArea(PastCap), GetMeshArea(AtCap), 1.0);
+		});
+	});
+
+	Describe("LOD Pyramid", [this]()
+	{
+		It("should give every site a parent that lists it as a child", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.MapSize = FVector2D(2000, 2000);
+			Settings.Seed = 1337;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+
+			FMapGraphPyramid Pyramid;
+			Pyramid.MinSites = 50;
+
+			// Act
+			Pyramid.Build(Graph.Sites, Settings.Spacing, true, FBox2D(FVector2D::ZeroVector, Settings.MapSize));
+
+			// Assert
+			if (!TestTrue(TEXT("Pyramid should have coarser levels"), Pyramid.NumLevels() > 1))
+			{
+				return;
+			}
+
+			for (int32 LevelIndex = 0; LevelIndex + 1 < Pyramid.NumLevels(); ++LevelIndex)
+			{
+				const FMapGraphLevel& Fine = Pyramid.GetLevel(LevelIndex);
+				const FMapGraphLevel& Coarse = Pyramid.GetLevel(LevelIndex + 1);
+				TestTrue(TEXT("Coarser level should have fewer sites"), Coarse.Num() < Fine.Num());
+
+				for (int32 Site = 0; Site < Fine.Num(); ++Site)
+				{
+					TestTrue(TEXT("Parent should list the site"), Coarse.Children[Fine.Parents[Site]].Contains(Site));
+				}
+			}
+		});
+
+		It("should tile the map with coarse cells", [this]()
+		{
+			// Arrange
+			FMapGraphSettings Settings;
+			Settings.MapSize = FVector2D(2000, 2000);
+			Settings.Seed = 21;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+
+			FMapGraphPyramid Pyramid;
+			Pyramid.MinSites = 50;
+			const FBox2D MapBounds(FVector2D::ZeroVector, Settings.MapSize);
+
+			// Act
+			Pyramid.Build(Graph.Sites, Settings.Spacing, true, MapBounds);
+
+			// Assert
+			if (!TestTrue(TEXT("Pyramid should have coarser levels"), Pyramid.NumLevels() > 1))
+			{
+				return;
+			}
+
+			for (int32 LevelIndex = 1; LevelIndex < Pyramid.NumLevels(); ++LevelIndex)
+			{
+				const FMapGraphLevel& Level = Pyramid.GetLevel(LevelIndex);
+				double Area = 0.0;
+				for (int32 Cell = 0; Cell < Level.Num(); ++Cell)
+				{
+					const TArrayView<const FVector2D> Outline = Level.GetCellVertices(Cell);
+					for (int32 Index = 0; Index < Outline.Num(); ++Index)
+					{
+						TestTrue(TEXT("Cells should stay inside the map"), MapBounds.ExpandBy(1e-3).IsInside(Outline[Index]));
+						Area += FVector2D::CrossProduct(Outline[Index], Outline[(Index + 1) % Outline.Num()]) / 2;
+					}
+				}
+
+				// Holes Along the Border or Cells Overhanging it Would Change the Total
+				TestEqual(TEXT("Cells should cover the map exactly"), FMath::Abs(Area), Settings.MapSize.X * Settings.MapSize.Y, 1.0);
+			}
+		});
+
+		It("should parent every node of a compacted map to its nearest coarse site", [this]()
+		{
+			// Arrange, Compaction Drops the Hull & Out of Map Cells Before the Pyramid is Built
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+			MapGen->bUseLODPyramid = true;
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.MapSize = FVector2D(3000, 3000);
+			Settings.Seed = 7;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+
+			// Act
+			MapGen->ApplyGraph(Settings, Graph);
+
+			// Assert
+			const FMapGraphPyramid& Pyramid = MapGen->GetPyramid();
+			if (!TestTrue(TEXT("Pyramid should have coarser levels"), Pyramid.NumLevels() > 1))
+			{
+				return;
+			}
+
+			TestEqual(TEXT("Full resolution level should hold every node"), Pyramid.GetLevel(0).Num(), MapGen->GetNodes().Num());
+			for (int32 LevelIndex = 0; LevelIndex + 1 < Pyramid.NumLevels(); ++LevelIndex)
+			{
+				const FMapGraphLevel& Fine = Pyramid.GetLevel(LevelIndex);
+				const FMapGraphLevel& Coarse = Pyramid.GetLevel(LevelIndex + 1);
+				for (int32 Site = 0; Site < Fine.Num(); ++Site)
+				{
+					double BestDistanceSquared = TNumericLimits<double>::Max();
+					for (const FVector2D& CoarseSite : Coarse.Graph.Sites)
+					{
+						BestDistanceSquared = FMath::Min(BestDistanceSquared, FVector2D::DistSquared(Fine.Graph.Sites[Site], CoarseSite));
+					}
+
+					const double ParentDistanceSquared = FVector2D::DistSquared(Fine.Graph.Sites[Site], Coarse.Graph.Sites[Fine.Parents[Site]]);
+					TestEqual(TEXT("Parent should be the nearest coarse site"), ParentDistanceSquared, BestDistanceSquared);
+				}
+			}
+		});
+	});
+
+	Describe("Raster Cache", [this]()
+	{
+		It("should fill the pixels inside a triangle of either winding", [this]()
+		{
+			// Arrange
+			FMapRaster Raster;
+			Raster.Reset(FBox2D(FVector2D(0, 0), FVector2D(100, 100)), FIntPoint(10, 10), FColor::Transparent);
+
+			// Act
+			Raster.FillTriangle(FVector2D(0, 0), FVector2D(100, 0), FVector2D(0, 100), FColor::Red);
+			Raster.FillTriangle(FVector2D(100, 100), FVector2D(100, 50), FVector2D(50, 100), FColor::Blue);
+
+			// Assert
+			TestEqual(TEXT("Pixel inside the first triangle should be filled"), Raster.GetPixel(FIntPoint(1, 1)), FColor::Red);
+			TestEqual(TEXT("Pixel inside the second triangle should be filled"), Raster.GetPixel(FIntPoint(9, 9)), FColor::Blue);
+			TestEqual(TEXT("Pixel outside both triangles should stay clear"), Raster.GetPixel(FIntPoint(7, 6)), FColor::Transparent);
+		});
+
+		It("should blend each pixel once per line", [this]()
+		{
+			// Arrange, a Line That Doubles Back Over Itself
+			FMapRaster Raster;
+			Raster.Reset(FBox2D(FVector2D(0, 0), FVector2D(100, 100)), FIntPoint(10, 10), FColor::Black);
+			const TArray<FVector2D> Points = { FVector2D(5, 55), FVector2D(95, 55), FVector2D(5, 55) };
+			const FColor HalfWhite(255, 255, 255, 128);
+
+			// Act
+			Raster.DrawLine(Points, HalfWhite);
+			const FColor AfterOneLine = Raster.GetPixel(FIntPoint(5, 5));
+			Raster.DrawLine(Points, HalfWhite);
+
+			// Assert
+			TestEqual(TEXT("Overlapping segments should blend once"), static_cast<int32>(AfterOneLine.R), 128);
+			TestTrue(TEXT("A second line should blend again"), Raster.GetPixel(FIntPoint(5, 5)).R > AfterOneLine.R);
+		});
+
+		It("should draw copied shapes the same as drawing them directly", [this]()
+		{
+			// Arrange
+			const FBox2D Bounds(FVector2D(0, 0), FVector2D(100, 100));
+			const TArray<FVector2D> FirstLine = { FVector2D(5, 55), FVector2D(95, 55) };
+			const TArray<FVector2D> SecondLine = { FVector2D(55, 5), FVector2D(55, 95), FVector2D(5, 95) };
+			const FColor HalfWhite(255, 255, 255, 128);
+
+			FMapRaster Direct;
+			Direct.Reset(Bounds, FIntPoint(10, 10), FColor::Transparent);
+			Direct.FillTriangle(FVector2D(0, 0), FVector2D(100, 0), FVector2D(0, 100), FColor::Red);
+			Direct.DrawLine(FirstLine, HalfWhite);
+			Direct.DrawLine(SecondLine, HalfWhite);
+
+			FMapRasterShapes Shapes;
+			Shapes.AddTriangle(FVector2D(0, 0), FVector2D(100, 0), FVector2D(0, 100), FColor::Red);
+			Shapes.AddLine(FirstLine, HalfWhite);
+			Shapes.AddLine(SecondLine, HalfWhite);
+
+			// Act
+			FMapRaster Copied;
+			Copied.Reset(Bounds, FIntPoint(10, 10), FColor::Transparent);
+			Copied.DrawShapes(Shapes);
+
+			// Assert
+			TestTrue(TEXT("Copied shapes should produce the same pixels"), Copied.GetPixels() == Direct.GetPixels());
+		});
+	});
+}
+
+
+BEGIN_DEFINE_SPEC(FMapQueryBenchmarks, "MapGenerationTests.Benchmarks", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+END_DEFINE_SPEC(FMapQueryBenchmarks)
+
+
+void FMapQueryBenchmarks::Define()
+{
+	Describe("Nearest Site Queries", [this]()
+	{
+		It("should report how many nearest-site queries run per second", [this]()
+		{
+			// Arrange
+			UMapGeneration* MapGen = NewObject<UMapGeneration>();
+
+			FMapGraphSettings Settings = MapGen->MakeGraphSettings();
+			Settings.Seed = 7;
+
+			FMapGraphData Graph;
+			FMapGraphBuilder::Build(Settings, Graph);
+			MapGen->ApplyGraph(Settings, Graph);
+
+			constexpr int32 NumQueries = 1000000;
+			TArray<FVector2D> Points;
+			Points.SetNumUninitialized(NumQueries);
+
+			FRandomStream RandomStream(42);
+			for (FVector2D& Point : Points)
+			{
+				Point = FVector2D(RandomStream.FRandRange(0, Settings.MapSize.X), RandomStream.FRandRange(0, Settings.MapSize.Y));
+			}
 
+			// Act
+			int32 NumFound = 0;
+			const double StartTime = FPlatformTime::Seconds();
+			for (const FVector2D& Point : Points)
+			{
+				NumFound += MapGen->FindNodeAt(Point) != nullptr ? 1 : 0;
+			}
+			const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
 
+			// Assert
+			TestEqual(TEXT("Every query inside the map should find a node"), NumFound, NumQueries);
+			AddInfo(FString::Printf(TEXT("%d sites, %.2f million FindNodeAt queries per second"), MapGen->GetNodes().Num(),
+				NumQueries / FMath::Max(ElapsedSeconds, UE_DOUBLE_SMALL_NUMBER) / 1e6));
+		});
 	});
 }
@@ -12,7 +12,7 @@ public class VoronoiMap : ModuleRules
         PublicDependencyModuleNames.AddRange(new string[] { "Core", "CoreUObject", "Engine", "InputCore", "AutomationTest",
             "Delaunator", "GeometryCore", "SimplexNoise" });
 
-        PrivateDependencyModuleNames.AddRange(new string[] { });
+        PrivateDependencyModuleNames.AddRange(new string[] { "Json" });
 
         // PrivateIncludePaths.AddRange(new string[] { "Tests" });
 